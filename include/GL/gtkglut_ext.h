@@ -59,8 +59,63 @@ extern "C" {
  */
 #define  GLUT_ACTION_ON_WINDOW_CLOSE        0x01F9
 #define  GLUT_VERSION                       0x01FC
+#define  GLUT_RENDERING_CONTEXT             0x01FD
 #define  GTKGLUT_VERSION                    0x0201
 
+/*
+ * GtkGLUT specific glutGet/glutSetOption parameters
+ */
+#define  GTKGLUT_FRAME_RATE                 0x0300
+#define  GTKGLUT_CONTEXT_SWITCHES           0x0301
+#define  GTKGLUT_MOTION_COMPRESSION         0x0302
+#define  GTKGLUT_IDLE_POLICY                0x0305
+#define  GTKGLUT_SKIP_HIDDEN_REDISPLAY      0x0306
+#define  GTKGLUT_GEOMETRY_CACHE             0x0307
+#define  GTKGLUT_POINTER_CACHE              0x0308
+#define  GTKGLUT_EVENT_DISPATCH             0x0309
+#define  GTKGLUT_MAX_FRAMES_IN_FLIGHT       0x030A
+#define  GTKGLUT_FRAME_STATS                0x030B
+#define  GTKGLUT_FRAME_DISPLAY_TIME         0x030C
+#define  GTKGLUT_FRAME_SWAP_INTERVAL        0x030D
+#define  GTKGLUT_FRAME_GPU_TIME             0x030E
+#define  GTKGLUT_MESH_CACHE_SIZE            0x030F
+#define  GTKGLUT_TEAPOT_GRID                0x0310
+
+/*
+ * GtkGLUT specific glutGet64 parameters
+ */
+#define  GTKGLUT_ELAPSED_TIME_USEC          0x0303
+#define  GTKGLUT_ELAPSED_TIME_NSEC          0x0304
+
+/*
+ * Freeglut extended special keys
+ */
+#define  GLUT_KEY_NUM_LOCK                  0x006D
+#define  GLUT_KEY_BEGIN                     0x006E
+#define  GLUT_KEY_DELETE                    0x006F
+#define  GLUT_KEY_SHIFT_L                   0x0070
+#define  GLUT_KEY_SHIFT_R                   0x0071
+#define  GLUT_KEY_CTRL_L                    0x0072
+#define  GLUT_KEY_CTRL_R                    0x0073
+#define  GLUT_KEY_ALT_L                     0x0074
+#define  GLUT_KEY_ALT_R                     0x0075
+
+/*
+ * GTKGLUT_IDLE_POLICY values
+ */
+#define  GTKGLUT_IDLE_ALWAYS                0
+#define  GTKGLUT_IDLE_ONCE_PER_FRAME        1
+#define  GTKGLUT_IDLE_WHEN_VISIBLE          2
+
+/*
+ * 64-bit integer
+ */
+#if defined(_MSC_VER)
+typedef __int64 GLUTint64;
+#else
+typedef long long GLUTint64;
+#endif
+
 /*
  * 4 and 5 button on mouse
  */
@@ -75,6 +130,18 @@ extern "C" {
 
 extern void glutMouseWheelFunc(void (*func) (int wheel, int direction, int x, int y));
 
+/*
+ * Motion history
+ */
+typedef struct GLUTmotionSample {
+	int x;
+	int y;
+	unsigned int time;
+} GLUTmotionSample;
+
+extern void glutMotionHistoryFunc(void (*func) (int state, int count,
+    const GLUTmotionSample * samples));
+
 /*
  * Font stuff
  */
@@ -89,10 +156,87 @@ void glutStrokeString(void *font, const unsigned char *string);
 extern void glutMainLoopEvent(void);
 extern void glutLeaveMainLoop(void);
 
+typedef struct GLUTloopStats {
+	int events;
+	GLUTint64 elapsed;
+	GLUTint64 next_timer;
+	GLUTint64 next_redisplay;
+} GLUTloopStats;
+
+extern int glutMainLoopEventBudget(GLUTint64 budget_usec, int max_events,
+    GLUTloopStats * stats);
+
+/*
+ * Timers with handle
+ */
+extern int glutAddTimer(unsigned int msecs, unsigned int period, void (*func) (int value),
+    int value);
+extern int glutAddTimerUsec(GLUTint64 usecs, GLUTint64 period, void (*func) (int value),
+    int value);
+extern void glutCancelTimer(int timer);
+
+/*
+ * Posting from other threads
+ */
+extern void glutThreadPostWindowRedisplay(int win);
+extern void glutThreadPostTask(void (*func) (void *data), void *data);
+
 /*
  * State settings
  */
 extern void glutSetOption(int what, int value);
+extern GLUTint64 glutGet64(GLenum state);
+extern void glutGetv(const GLenum * states, int *out, int n);
+
+/*
+ * Buffer swap control
+ */
+extern void glutSwapInterval(int interval);
+
+/*
+ * Frame statistics
+ */
+typedef struct GLUTframeTime {
+	int samples;
+	int min;
+	int avg;
+	int p99;
+	int max;
+} GLUTframeTime;
+
+typedef struct GLUTframeStats {
+	int frames;
+	GLUTframeTime display_time;
+	GLUTframeTime swap_interval;
+	GLUTframeTime gpu_time;
+} GLUTframeStats;
+
+extern int glutGetFrameStats(GLUTframeStats * stats);
+extern void glutResetFrameStats(void);
+
+/*
+ * Instanced drawing of geometric objects
+ */
+extern void glutSolidSphereInstanced(GLdouble radius, GLint slices, GLint stacks, int count,
+    const GLfloat * matrices, const GLfloat * colors);
+extern void glutWireSphereInstanced(GLdouble radius, GLint slices, GLint stacks, int count,
+    const GLfloat * matrices, const GLfloat * colors);
+extern void glutSolidCubeInstanced(GLdouble size, int count, const GLfloat * matrices,
+    const GLfloat * colors);
+extern void glutWireCubeInstanced(GLdouble size, int count, const GLfloat * matrices,
+    const GLfloat * colors);
+extern void glutSolidConeInstanced(GLdouble base, GLdouble height, GLint slices, GLint stacks,
+    int count, const GLfloat * matrices, const GLfloat * colors);
+extern void glutWireConeInstanced(GLdouble base, GLdouble height, GLint slices, GLint stacks,
+    int count, const GLfloat * matrices, const GLfloat * colors);
+extern void glutSolidTorusInstanced(GLdouble innerRadius, GLdouble outerRadius, GLint nsides,
+    GLint rings, int count, const GLfloat * matrices, const GLfloat * colors);
+extern void glutWireTorusInstanced(GLdouble innerRadius, GLdouble outerRadius, GLint nsides,
+    GLint rings, int count, const GLfloat * matrices, const GLfloat * colors);
+extern void glutSolidCylinderInstanced(GLdouble radius, GLdouble height, GLint slices,
+    GLint stacks, int count, const GLfloat * matrices, const GLfloat * colors);
+extern void glutWireCylinderInstanced(GLdouble radius, GLdouble height, GLint slices,
+    GLint stacks, int count, const GLfloat * matrices, const GLfloat * colors);
 
 /*
  * Close window registration
@@ -0,0 +1,89 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* cylinder_mesh_test measures, how fast cylinder meshes are
+   generated.  With mesh cache disabled, every call of
+   glutSolidCylinderInstanced builds mesh from circle table and
+   draws it once from client arrays.  Same calls with enabled
+   cache only draw cached mesh, so difference of both rates is
+   cost of generation.  Immediate mode glutSolidCylinder is
+   printed for comparison. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define CALLS 2000
+
+int slices[] = {8, 16, 32, 64};
+GLfloat identity[16] = {
+  1.0, 0.0, 0.0, 0.0,
+  0.0, 1.0, 0.0, 0.0,
+  0.0, 0.0, 1.0, 0.0,
+  0.0, 0.0, 0.0, 1.0
+};
+
+double
+measure(int mode, int s)
+{
+  GLUTint64 start;
+  int i;
+
+  glFinish();
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  for (i = 0; i < CALLS; i++) {
+    if (mode == 0)
+      glutSolidCylinder(0.5, 1.0, s, 4);
+    else
+      glutSolidCylinderInstanced(0.5, 1.0, s, 4, 1, identity, NULL);
+  }
+  glFinish();
+
+  return (double) CALLS * 1000000.0 /
+    (double) (glutGet64(GTKGLUT_ELAPSED_TIME_USEC) - start + 1);
+}
+
+void
+display(void)
+{
+  double immediate, generated, cached;
+  int cache_size;
+  int i;
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  cache_size = glutGet(GTKGLUT_MESH_CACHE_SIZE);
+
+  printf("slices  immediate  generated     cached  (calls/s)\n");
+  for (i = 0; i < sizeof(slices) / sizeof(slices[0]); i++) {
+    glutSetOption(GTKGLUT_MESH_CACHE_SIZE, 0);
+    immediate = measure(0, slices[i]);
+    generated = measure(1, slices[i]);
+    glutSetOption(GTKGLUT_MESH_CACHE_SIZE, cache_size);
+    cached = measure(1, slices[i]);
+    printf("%6d %10.0f %10.0f %10.0f\n", slices[i], immediate, generated, cached);
+  }
+
+  glutSwapBuffers();
+  exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+  glutInitWindowSize(300, 300);
+  glutCreateWindow("cylinder mesh test");
+  glutDisplayFunc(display);
+
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_LIGHTING);
+  glEnable(GL_LIGHT0);
+
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
@@ -0,0 +1,56 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* Shared part of tests, which feed synthetic GDK events to
+   GtkGLUT window.  glut_drawing_area() returns drawing area of
+   first GtkGLUT window, so it must be called after window is
+   realized (for example from display callback).  Include after
+   stdio.h, stdlib.h and gtk/gtk.h. */
+
+#ifndef DRAWING_AREA_H
+#define DRAWING_AREA_H
+
+static GtkWidget *
+find_drawing_area(GtkWidget *widget)
+{
+  GList *children, *l;
+  GtkWidget *res;
+
+  if (GTK_IS_DRAWING_AREA(widget))
+    return widget;
+  if (!GTK_IS_CONTAINER(widget))
+    return NULL;
+
+  res = NULL;
+  children = gtk_container_get_children(GTK_CONTAINER(widget));
+  for (l = children; l && !res; l = l->next)
+    res = find_drawing_area(GTK_WIDGET(l->data));
+  g_list_free(children);
+
+  return res;
+}
+
+static GtkWidget *
+glut_drawing_area(void)
+{
+  GList *toplevels, *l;
+  GtkWidget *area;
+
+  area = NULL;
+  toplevels = gtk_window_list_toplevels();
+  for (l = toplevels; l && !area; l = l->next)
+    area = find_drawing_area(GTK_WIDGET(l->data));
+  g_list_free(toplevels);
+
+  if (!area) {
+    printf("drawing area not found\n");
+    exit(1);
+  }
+
+  return area;
+}
+
+#endif /* DRAWING_AREA_H */
@@ -0,0 +1,115 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* event_dispatch_test measures cost of delivering input
+   events to GLUT callbacks.  Synthetic motion and button
+   events are put to GDK event queue and main loop is run
+   until queue is empty, first with GtkGLUT event dispatcher
+   disabled (every event goes through GTK+ signal emission)
+   and then enabled. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <GL/gtkglut.h>
+#include "drawing_area.h"
+
+#define MEASURE_USEC 1000000
+#define BATCH 100
+
+long callbacks;
+
+/* ARGSUSED */
+void
+motion(int x, int y)
+{
+  callbacks++;
+}
+
+/* ARGSUSED */
+void
+mouse(int button, int state, int x, int y)
+{
+  callbacks++;
+}
+
+double
+measure(GtkWidget *area, int dispatch)
+{
+  GdkEventMotion motion_event;
+  GdkEventButton button_event;
+  GLUTint64 start, now;
+  long events;
+  int i;
+
+  glutSetOption(GTKGLUT_EVENT_DISPATCH, dispatch);
+
+  memset(&motion_event, 0, sizeof(motion_event));
+  motion_event.type = GDK_MOTION_NOTIFY;
+  motion_event.window = area->window;
+  motion_event.send_event = TRUE;
+  motion_event.state = GDK_BUTTON1_MASK;
+
+  memset(&button_event, 0, sizeof(button_event));
+  button_event.window = area->window;
+  button_event.send_event = TRUE;
+  button_event.button = 1;
+
+  events = 0;
+  callbacks = 0;
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  do {
+    for (i = 0; i < BATCH; i++) {
+      motion_event.x = i;
+      motion_event.y = i;
+      gdk_event_put((GdkEvent *) &motion_event);
+      button_event.type = (i & 1) ? GDK_BUTTON_RELEASE : GDK_BUTTON_PRESS;
+      gdk_event_put((GdkEvent *) &button_event);
+    }
+    while (gtk_events_pending())
+      gtk_main_iteration();
+    events += 2 * BATCH;
+    now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  } while (now - start < MEASURE_USEC);
+
+  if (callbacks != events)
+    printf("warning: %ld events, %ld callbacks\n", events, callbacks);
+
+  return (double) (now - start) * 1000.0 / (double) events;
+}
+
+void
+display(void)
+{
+  GtkWidget *area;
+  double signals, dispatcher;
+
+  glClear(GL_COLOR_BUFFER_BIT);
+  glFlush();
+
+  area = glut_drawing_area();
+
+  signals = measure(area, 0);
+  dispatcher = measure(area, 1);
+
+  printf("GTK+ signals:     %8.0f ns/event\n", signals);
+  printf("event dispatcher: %8.0f ns/event\n", dispatcher);
+
+  exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutCreateWindow("event dispatch test");
+  glutDisplayFunc(display);
+  glutMotionFunc(motion);
+  glutMouseFunc(mouse);
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
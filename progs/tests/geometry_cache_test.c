@@ -0,0 +1,75 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* geometry_cache_test measures how many window geometry
+   queries (glutGet with GLUT_WINDOW_X, GLUT_WINDOW_Y,
+   GLUT_WINDOW_WIDTH and GLUT_WINDOW_HEIGHT) can be done per
+   second with GtkGLUT geometry cache disabled and enabled.
+   Without cache, every position query is round trip to X
+   server, so run it also under Xvfb or remote display to
+   see the difference. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define MEASURE_USEC 1000000
+
+int sink;
+
+double
+measure(int cache)
+{
+  GLUTint64 start, now;
+  long queries;
+  int i;
+
+  glutSetOption(GTKGLUT_GEOMETRY_CACHE, cache);
+
+  queries = 0;
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  do {
+    for (i = 0; i < 100; i++) {
+      sink += glutGet(GLUT_WINDOW_X);
+      sink += glutGet(GLUT_WINDOW_Y);
+      sink += glutGet(GLUT_WINDOW_WIDTH);
+      sink += glutGet(GLUT_WINDOW_HEIGHT);
+    }
+    queries += 400;
+    now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  } while (now - start < MEASURE_USEC);
+
+  return (double) queries * 1000000.0 / (double) (now - start);
+}
+
+void
+display(void)
+{
+  double without_cache, with_cache;
+
+  glClear(GL_COLOR_BUFFER_BIT);
+  glFlush();
+
+  without_cache = measure(0);
+  with_cache = measure(1);
+
+  printf("without cache: %12.0f queries/s\n", without_cache);
+  printf("with cache:    %12.0f queries/s\n", with_cache);
+  printf("speedup:       %12.1fx\n", with_cache / without_cache);
+
+  exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutInitWindowSize(300, 300);
+  glutCreateWindow("geometry cache test");
+  glutDisplayFunc(display);
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
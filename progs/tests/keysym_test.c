@@ -0,0 +1,213 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* keysym_test feeds synthetic GdkEventKey structures for
+   character, function, cursor, keypad and modifier keys
+   directly to GtkGLUT key handler.  First it checks, that
+   every keysym is delivered to expected callback with expected
+   key, then it measures how many key events per second are
+   translated and delivered to keyboard and special
+   callbacks. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <gdk/gdkkeysyms.h>
+#include <GL/gtkglut.h>
+#include "drawing_area.h"
+
+#define MEASURE_USEC 1000000
+
+#define NONE      0
+#define CHARACTER 1
+#define SPECIAL   2
+
+struct {
+  guint keyval;
+  guint state;
+  int callback;
+  int key;
+} keys[] =
+{
+  {GDK_a, 0, CHARACTER, 'a'},
+  {GDK_Z, GDK_SHIFT_MASK, CHARACTER, 'Z'},
+  {GDK_space, 0, CHARACTER, ' '},
+  {GDK_5, 0, CHARACTER, '5'},
+  {GDK_eacute, 0, CHARACTER, 0xE9},
+  {GDK_a, GDK_CONTROL_MASK, CHARACTER, 1},
+  {GDK_z, GDK_CONTROL_MASK, CHARACTER, 26},
+  {GDK_bracketleft, GDK_CONTROL_MASK, CHARACTER, 27},
+  {GDK_2, GDK_CONTROL_MASK, CHARACTER, 0},
+  {GDK_Return, 0, CHARACTER, 13},
+  {GDK_Tab, 0, CHARACTER, 9},
+  {GDK_ISO_Left_Tab, GDK_SHIFT_MASK, CHARACTER, 9},
+  {GDK_BackSpace, 0, CHARACTER, 8},
+  {GDK_Delete, 0, CHARACTER, 127},
+  {GDK_Escape, 0, CHARACTER, 27},
+  {GDK_KP_7, 0, CHARACTER, '7'},
+  {GDK_KP_Add, 0, CHARACTER, '+'},
+  {GDK_KP_Enter, 0, CHARACTER, 13},
+  {GDK_KP_Delete, 0, CHARACTER, 127},
+  {GDK_F1, 0, SPECIAL, GLUT_KEY_F1},
+  {GDK_F12, 0, SPECIAL, GLUT_KEY_F12},
+  {GDK_KP_F4, 0, SPECIAL, GLUT_KEY_F4},
+  {GDK_Left, 0, SPECIAL, GLUT_KEY_LEFT},
+  {GDK_Prior, 0, SPECIAL, GLUT_KEY_PAGE_UP},
+  {GDK_Home, 0, SPECIAL, GLUT_KEY_HOME},
+  {GDK_KP_Home, 0, SPECIAL, GLUT_KEY_HOME},
+  {GDK_KP_Next, 0, SPECIAL, GLUT_KEY_PAGE_DOWN},
+  {GDK_KP_Begin, 0, SPECIAL, GLUT_KEY_BEGIN},
+  {GDK_Insert, 0, SPECIAL, GLUT_KEY_INSERT},
+  {GDK_Shift_L, 0, SPECIAL, GLUT_KEY_SHIFT_L},
+  {GDK_Shift_R, 0, SPECIAL, GLUT_KEY_SHIFT_R},
+  {GDK_Control_L, 0, SPECIAL, GLUT_KEY_CTRL_L},
+  {GDK_Control_R, 0, SPECIAL, GLUT_KEY_CTRL_R},
+  {GDK_Alt_L, 0, SPECIAL, GLUT_KEY_ALT_L},
+  {GDK_Alt_R, 0, SPECIAL, GLUT_KEY_ALT_R},
+  {GDK_Num_Lock, 0, SPECIAL, GLUT_KEY_NUM_LOCK},
+  {GDK_Caps_Lock, 0, NONE, 0},
+};
+
+#define NUM_KEYS (sizeof(keys) / sizeof(keys[0]))
+
+int last_callback;
+int last_key;
+long characters;
+long specials;
+
+/* ARGSUSED1 */
+void
+keyboard(unsigned char key, int x, int y)
+{
+  last_callback = CHARACTER;
+  last_key = key;
+  characters++;
+}
+
+/* ARGSUSED1 */
+void
+special(int key, int x, int y)
+{
+  last_callback = SPECIAL;
+  last_key = key;
+  specials++;
+}
+
+int
+check(GtkWidget *area)
+{
+  static char *names[] = {"none", "keyboard", "special"};
+  GdkEventKey key;
+  unsigned int i;
+  int failed;
+
+  memset(&key, 0, sizeof(key));
+  key.type = GDK_KEY_PRESS;
+  key.window = area->window;
+  key.send_event = TRUE;
+
+  failed = 0;
+  for (i = 0; i < NUM_KEYS; i++) {
+    key.keyval = keys[i].keyval;
+    key.state = keys[i].state;
+    last_callback = NONE;
+    last_key = -1;
+    gtk_widget_event(area, (GdkEvent *) &key);
+    if (last_callback != keys[i].callback ||
+      (keys[i].callback != NONE && last_key != keys[i].key)) {
+      printf("FAIL: %s (state 0x%x) gave %s %d, expected %s %d\n",
+        gdk_keyval_name(keys[i].keyval), keys[i].state,
+        names[last_callback], last_key,
+        names[keys[i].callback], keys[i].key);
+      failed++;
+    }
+  }
+
+  return failed;
+}
+
+void
+run(GtkWidget *area)
+{
+  GdkEventCrossing crossing;
+  GdkEventKey key;
+  GLUTint64 start, now;
+  long events;
+  unsigned int i;
+  int failed;
+
+  /* Pretend pointer entered window, so pointer cache is valid. */
+  memset(&crossing, 0, sizeof(crossing));
+  crossing.type = GDK_ENTER_NOTIFY;
+  crossing.window = area->window;
+  crossing.send_event = TRUE;
+  crossing.x = 10;
+  crossing.y = 10;
+  gtk_widget_event(area, (GdkEvent *) &crossing);
+
+  failed = check(area);
+  if (failed) {
+    printf("%d of %d keysyms translated wrong\n", failed, (int) NUM_KEYS);
+    exit(1);
+  }
+  printf("all %d keysyms translated correctly\n", (int) NUM_KEYS);
+
+  characters = 0;
+  specials = 0;
+
+  memset(&key, 0, sizeof(key));
+  key.window = area->window;
+  key.send_event = TRUE;
+
+  events = 0;
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  do {
+    for (i = 0; i < NUM_KEYS; i++) {
+      key.type = GDK_KEY_PRESS;
+      key.keyval = keys[i].keyval;
+      key.state = keys[i].state;
+      gtk_widget_event(area, (GdkEvent *) &key);
+      key.type = GDK_KEY_RELEASE;
+      gtk_widget_event(area, (GdkEvent *) &key);
+    }
+    events += 2 * NUM_KEYS;
+    now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  } while (now - start < MEASURE_USEC);
+
+  printf("key events:        %12.0f events/s\n",
+    (double) events * 1000000.0 / (double) (now - start));
+  printf("keyboard callbacks: %11ld\n", characters);
+  printf("special callbacks:  %11ld\n", specials);
+}
+
+void
+display(void)
+{
+  GtkWidget *area;
+
+  glClear(GL_COLOR_BUFFER_BIT);
+  glFlush();
+
+  area = glut_drawing_area();
+
+  run(area);
+  exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutCreateWindow("keysym test");
+  glutDisplayFunc(display);
+  glutKeyboardFunc(keyboard);
+  glutKeyboardUpFunc(keyboard);
+  glutSpecialFunc(special);
+  glutSpecialUpFunc(special);
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
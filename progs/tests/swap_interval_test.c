@@ -0,0 +1,96 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* swap_interval_test renders simple scene to double buffered
+   window as fast as possible with swap interval 0, 1 and -1
+   (adaptive) and prints average, minimal and maximal frame
+   time.  Under Xvfb with Mesa llvmpipe, interval has no
+   effect and difference comes only from glutSwapBuffers
+   overhead. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define FRAMES 500
+
+int intervals[] = {0, 1, -1};
+int interval;
+int frame;
+GLUTint64 last, sum, min, max;
+
+void
+report(void)
+{
+  printf("interval %2d: avg %8.1f min %8ld max %8ld us/frame\n",
+    intervals[interval], (double) sum / FRAMES, (long) min, (long) max);
+}
+
+void
+start_interval(void)
+{
+  glutSwapInterval(intervals[interval]);
+  frame = -1;
+  sum = max = 0;
+  min = 0x7fffffff;
+}
+
+void
+display(void)
+{
+  GLUTint64 now, t;
+
+  glClear(GL_COLOR_BUFFER_BIT);
+  glRotatef(1.0, 0.0, 0.0, 1.0);
+  glBegin(GL_TRIANGLES);
+  glColor3f(1.0, 0.0, 0.0);
+  glVertex2f(-0.5, -0.5);
+  glColor3f(0.0, 1.0, 0.0);
+  glVertex2f(0.5, -0.5);
+  glColor3f(0.0, 0.0, 1.0);
+  glVertex2f(0.0, 0.5);
+  glEnd();
+  glutSwapBuffers();
+
+  now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  /* First frame of every interval is not measured. */
+  if (frame >= 0) {
+    t = now - last;
+    sum += t;
+    if (t < min)
+      min = t;
+    if (t > max)
+      max = t;
+  }
+  last = now;
+  frame++;
+
+  if (frame == FRAMES) {
+    report();
+    interval++;
+    if (interval == sizeof(intervals) / sizeof(intervals[0]))
+      exit(0);
+    start_interval();
+  }
+
+  glutPostRedisplay();
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE);
+  glutInitWindowSize(300, 300);
+  glutCreateWindow("swap interval test");
+  glutDisplayFunc(display);
+
+  interval = 0;
+  start_interval();
+
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
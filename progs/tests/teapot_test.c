@@ -0,0 +1,87 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* teapot_test compares drawing of teapot by OpenGL evaluators
+   (mesh cache disabled) with drawing of teapot tessellated on
+   CPU and kept in mesh cache.  Evaluators use fixed grid of
+   GdkGLExt, so cached mesh is measured for several values of
+   GTKGLUT_TEAPOT_GRID.  Time of first call, which tessellates
+   mesh, is printed too. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define CALLS 500
+
+int grids[] = {4, 7, 10, 14, 20};
+
+double
+measure(int solid, int calls)
+{
+  GLUTint64 start;
+  int i;
+
+  glFinish();
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  for (i = 0; i < calls; i++) {
+    if (solid)
+      glutSolidTeapot(1.0);
+    else
+      glutWireTeapot(1.0);
+  }
+  glFinish();
+
+  return (double) (glutGet64(GTKGLUT_ELAPSED_TIME_USEC) - start + 1);
+}
+
+void
+display(void)
+{
+  int cache_size, grid;
+  int solid, i;
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  cache_size = glutGet(GTKGLUT_MESH_CACHE_SIZE);
+  grid = glutGet(GTKGLUT_TEAPOT_GRID);
+
+  for (solid = 1; solid >= 0; solid--) {
+    glutSetOption(GTKGLUT_MESH_CACHE_SIZE, 0);
+    printf("%s teapot, evaluators: %.0f calls/s\n", solid ? "solid" : "wire",
+      CALLS * 1000000.0 / measure(solid, CALLS));
+    glutSetOption(GTKGLUT_MESH_CACHE_SIZE, cache_size);
+
+    printf("  grid  first call (us)     cached (calls/s)\n");
+    for (i = 0; i < sizeof(grids) / sizeof(grids[0]); i++) {
+      glutSetOption(GTKGLUT_TEAPOT_GRID, grids[i]);
+      printf("%6d %17.0f", grids[i], measure(solid, 1));
+      printf(" %20.0f\n", CALLS * 1000000.0 / measure(solid, CALLS));
+    }
+  }
+
+  glutSetOption(GTKGLUT_TEAPOT_GRID, grid);
+
+  glutSwapBuffers();
+  exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+  glutInitWindowSize(300, 300);
+  glutCreateWindow("teapot test");
+  glutDisplayFunc(display);
+
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_LIGHTING);
+  glEnable(GL_LIGHT0);
+
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
@@ -0,0 +1,146 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* timer_jitter_test measures how late timer callbacks are
+   called.  Same periodic schedule is driven by chained
+   glutTimerFunc calls, by periodic glutAddTimer timer and by
+   periodic glutAddTimerUsec timer.  For every method, minimal,
+   average, 99th percentile and maximal lateness (in
+   microseconds) is printed.  Run it on idle machine. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define SAMPLES 1000
+#define PERIOD_USEC 2000
+
+GLUTint64 lateness[SAMPLES];
+GLUTint64 deadline;
+int samples;
+int method;
+int timer_handle;
+
+char *method_name[] =
+{
+  "glutTimerFunc",
+  "glutAddTimer",
+  "glutAddTimerUsec",
+};
+
+void start_method(void);
+
+int
+compare(const void *a, const void *b)
+{
+  GLUTint64 x = *(const GLUTint64 *) a;
+  GLUTint64 y = *(const GLUTint64 *) b;
+
+  return (x < y) ? -1 : (x > y);
+}
+
+void
+report(void)
+{
+  GLUTint64 sum;
+  int i;
+
+  qsort(lateness, SAMPLES, sizeof(lateness[0]), compare);
+  sum = 0;
+  for (i = 0; i < SAMPLES; i++)
+    sum += lateness[i];
+
+  printf("%-18s min %6ld avg %6ld p99 %6ld max %6ld us\n", method_name[method],
+    (long) lateness[0], (long) (sum / SAMPLES),
+    (long) lateness[SAMPLES * 99 / 100], (long) lateness[SAMPLES - 1]);
+}
+
+/* Returns 1 when all samples of current method are collected. */
+int
+sample(void)
+{
+  GLUTint64 now;
+
+  now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  lateness[samples++] = now - deadline;
+  deadline += PERIOD_USEC;
+
+  if (samples < SAMPLES)
+    return 0;
+
+  report();
+  method++;
+  if (method == 3)
+    exit(0);
+  start_method();
+
+  return 1;
+}
+
+/* ARGSUSED */
+void
+timer_func(int value)
+{
+  if (!sample()) {
+    /* Chained timer is scheduled from now, so compensate
+       lateness of this call. */
+    glutTimerFunc((unsigned int) ((deadline -
+      glutGet64(GTKGLUT_ELAPSED_TIME_USEC) + 999) / 1000),
+      timer_func, 0);
+  }
+}
+
+/* ARGSUSED */
+void
+periodic_func(int value)
+{
+  int handle = timer_handle;
+
+  if (sample())
+    glutCancelTimer(handle);
+}
+
+void
+start_method(void)
+{
+  samples = 0;
+  deadline = glutGet64(GTKGLUT_ELAPSED_TIME_USEC) + PERIOD_USEC;
+
+  switch (method) {
+  case 0:
+    glutTimerFunc(PERIOD_USEC / 1000, timer_func, 0);
+    break;
+  case 1:
+    timer_handle = glutAddTimer(PERIOD_USEC / 1000, PERIOD_USEC / 1000,
+      periodic_func, 0);
+    break;
+  case 2:
+    timer_handle = glutAddTimerUsec(PERIOD_USEC, PERIOD_USEC, periodic_func, 0);
+    break;
+  }
+}
+
+void
+display(void)
+{
+  glClear(GL_COLOR_BUFFER_BIT);
+  glFlush();
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutCreateWindow("timer jitter test");
+  glutDisplayFunc(display);
+
+  printf("%d samples, period %d us\n", SAMPLES, PERIOD_USEC);
+  method = 0;
+  start_method();
+
+  glutMainLoop();
+  return 0;             /* ANSI C requires main to return int. */
+}
@@ -0,0 +1,106 @@
+/* Copyright (c) Jan Friesse, 2026. */
+
+/* This program is freely distributable without licensing fees
+   and is provided without guarantee or warrantee expressed or
+   implied. This program is -not- in the public domain. */
+
+/* window_churn_test creates and destroys many subwindows and
+   menus and reports time and resident memory.  Window and
+   menu ids of destroyed objects must be rejected even when
+   their slots are reused.  Run it under Xvfb, because it
+   takes a while on real display. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <GL/gtkglut.h>
+
+#define CHURN 100000
+#define REPORT 10000
+
+int main_window;
+
+long
+resident_kb(void)
+{
+#ifdef __linux__
+  FILE *f;
+  long size, resident;
+
+  f = fopen("/proc/self/statm", "r");
+  if (!f)
+    return -1;
+  if (fscanf(f, "%ld %ld", &size, &resident) != 2)
+    resident = -1;
+  fclose(f);
+  return resident * 4;
+#else
+  return -1;
+#endif
+}
+
+/* ARGSUSED */
+void
+menu_func(int value)
+{
+}
+
+void
+display(void)
+{
+  glClear(GL_COLOR_BUFFER_BIT);
+  glFlush();
+}
+
+void
+churn(void)
+{
+  GLUTint64 start, now;
+  int i, win, menu, first_win;
+
+  first_win = 0;
+  start = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+  printf("%8s %10s %10s %10s %12s\n", "count", "window", "menu", "RSS kB", "us/window");
+
+  for (i = 1; i <= CHURN; i++) {
+    win = glutCreateSubWindow(main_window, 0, 0, 10, 10);
+    glutDisplayFunc(display);
+    menu = glutCreateMenu(menu_func);
+    glutAddMenuEntry("entry", 1);
+    glutAttachMenu(GLUT_RIGHT_BUTTON);
+
+    glutDestroyMenu(menu);
+    glutDestroyWindow(win);
+    glutMainLoopEvent();
+
+    if (!first_win)
+      first_win = win;
+
+    if (i % REPORT == 0) {
+      now = glutGet64(GTKGLUT_ELAPSED_TIME_USEC);
+      printf("%8d %10d %10d %10ld %12.1f\n", i, win, menu, resident_kb(),
+        (double) (now - start) / (double) i);
+    }
+  }
+
+  /* Slot of first window is reused now, but its id must stay
+     invalid (GtkGLUT prints warning here). */
+  win = glutCreateSubWindow(main_window, 0, 0, 10, 10);
+  glutSetWindow(first_win);
+  if (glutGetWindow() == 0)
+    printf("stale window id %d rejected (slot reused by %d)\n", first_win, win);
+  else
+    printf("error: stale window id %d accepted\n", first_win);
+}
+
+int
+main(int argc, char **argv)
+{
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_RGB | GLUT_SINGLE);
+  main_window = glutCreateWindow("window churn test");
+  glutDisplayFunc(display);
+
+  churn();
+
+  return 0;             /* ANSI C requires main to return int. */
+}
@@ -80,7 +80,181 @@
  * explicit glutLeaveMainLoop().  Another is a mode of execution
  * that tells GtkGLUT what to do if a user closes one of your
  * windows.
+ *
+ * Redisplays posted by glutPostRedisplay() and expose events
+ * from the window system are collected in one set of damaged
+ * windows, and the set is flushed once per main loop iteration,
+ * after all pending events were dispatched.  So each window is
+ * redisplayed at most once per iteration, no matter how many
+ * times redisplay was requested.
+ *
+ * GtkGLUT can also pace redisplays.  After
+ * glutSetOption(GTKGLUT_FRAME_RATE, hz), the set is
+ * flushed only once per frame, on a deadline derived
+ * from a monotonic clock.  Events are processed in between
+ * frames and the main loop sleeps until the next deadline, so
+ * an application which posts a new redisplay from its display
+ * callback is animated at the given frame rate without an idle
+ * callback.
+ */
+
+/*
+ * Frame timer only wakes up main loop, redisplay source then finds deadline passed
+ */
+static void __gtkglut_frame_timer_func(int value)
+{
+
+	__gtkglut_context->frame_timer = 0;
+}
+
+/*
+ * Arm frame timer for frame deadline, which is remaining microseconds from now.
+ * Returns FALSE, if timer can't be armed.
+ */
+static gboolean __gtkglut_frame_timer_arm(gint64 remaining)
+{
+
+	if (__gtkglut_context->frame_timer != 0) {
+		if (__gtkglut_context->frame_timer_deadline == __gtkglut_context->frame_deadline)
+			return TRUE;
+
+		__gtkglut_timer_cancel(__gtkglut_context->frame_timer);
+	}
+
+	__gtkglut_context->frame_timer =
+	    __gtkglut_timer_add_precise(remaining, 0, __gtkglut_frame_timer_func, 0);
+	__gtkglut_context->frame_timer_deadline = __gtkglut_context->frame_deadline;
+
+	return __gtkglut_context->frame_timer != 0;
+}
+
+/*
+ * Redisplay source. Source is ready, when there is at least one window
+ * with pending redisplay and (for paced main loop) frame deadline passed.
+ */
+static gboolean __gtkglut_redisplay_source_prepare(GSource * source, gint * timeout)
+{
+	gint64 remaining;
+
+	*timeout = -1;
+
+	if (__gtkglut_context->dirty_windows->len == 0)
+		return FALSE;
+
+	if (__gtkglut_context->frame_period <= 0)
+		return TRUE;
+
+	remaining = __gtkglut_context->frame_deadline - __gtkglut_get_time_usec();
+
+	if (remaining <= 0)
+		return TRUE;
+
+	/*
+	 * Precise timer wakes us up at deadline, so poll is not limited by
+	 * millisecond granularity
+	 */
+	if (__gtkglut_timer_precise_wakeup() && __gtkglut_frame_timer_arm(remaining))
+		return FALSE;
+
+	/*
+	 * Round up. Frame may be late less than millisecond, but loop doesn't
+	 * busy poll.
+	 */
+	*timeout = (gint) ((remaining + 999) / 1000);
+
+	return FALSE;
+}
+
+static gboolean __gtkglut_redisplay_source_check(GSource * source)
+{
+	gint timeout;
+
+	return __gtkglut_redisplay_source_prepare(source, &timeout);
+}
+
+/*
+ * Execute all pending redisplays. Redisplays posted from display callbacks
+ * are executed in next iteration (or next frame).
+ */
+static gboolean __gtkglut_redisplay_source_dispatch(GSource * source, GSourceFunc callback,
+						    gpointer user_data)
+{
+	GPtrArray *dirty_windows;
+	gint64 now;
+	guint i;
+
+	if (__gtkglut_context->frame_period > 0) {
+		now = __gtkglut_get_time_usec();
+
+		__gtkglut_context->frame_deadline += __gtkglut_context->frame_period;
+
+		if (__gtkglut_context->frame_deadline <= now) {
+			/*
+			 * We are late (or loop was sleeping without any redisplay) -> don't
+			 * try to catch up, start new frame sequence
+			 */
+			__gtkglut_context->frame_deadline = now + __gtkglut_context->frame_period;
+		}
+	}
+
+	dirty_windows = __gtkglut_context->dirty_windows;
+	__gtkglut_context->dirty_windows = __gtkglut_context->dirty_windows_flush;
+	__gtkglut_context->dirty_windows_flush = dirty_windows;
+
+	for (i = 0; i < dirty_windows->len; i++) {
+		__gtkglut_display_window(GPOINTER_TO_INT(g_ptr_array_index(dirty_windows, i)));
+	}
+
+	g_ptr_array_set_size(dirty_windows, 0);
+
+	return TRUE;
+}
+
+static GSourceFuncs __gtkglut_redisplay_source_funcs = {
+	__gtkglut_redisplay_source_prepare,
+	__gtkglut_redisplay_source_check,
+	__gtkglut_redisplay_source_dispatch,
+	NULL
+};
+
+/*
+ * Create and attach redisplay source. Source has same priority as GDK redraw,
+ * so all pending events are processed before redisplay.
  */
+GSource *__gtkglut_redisplay_source_new(void)
+{
+	GSource *source;
+
+	source = g_source_new(&__gtkglut_redisplay_source_funcs, sizeof(GSource));
+	g_source_set_priority(source, GDK_PRIORITY_REDRAW);
+	g_source_attach(source, NULL);
+
+	return source;
+}
+
+/*
+ * Set frame rate of paced main loop. Value <= 0 disables pacing, so pending
+ * redisplays are executed in next main loop iteration.
+ */
+void __gtkglut_set_frame_rate(int frame_rate)
+{
+
+	if (__gtkglut_context->frame_timer != 0) {
+		__gtkglut_timer_cancel(__gtkglut_context->frame_timer);
+		__gtkglut_context->frame_timer = 0;
+	}
+
+	if (frame_rate <= 0) {
+		__gtkglut_context->frame_rate = 0;
+		__gtkglut_context->frame_period = 0;
+
+		return;
+	}
+
+	__gtkglut_context->frame_rate = frame_rate;
+	__gtkglut_context->frame_period = G_USEC_PER_SEC / frame_rate;
+	__gtkglut_context->frame_deadline = __gtkglut_get_time_usec();
+}
 
 /*!
  * \brief    The standard GLUT event loop entry point.
@@ -97,12 +271,17 @@
  * do special things to GtkGLUT to cause GtkGLUT's
  * version to return.
  *
+ * If frame rate was set by glutSetOption(GTKGLUT_FRAME_RATE, hz),
+ * posted redisplays are executed on frame deadlines and loop sleeps
+ * between frames.
+ *
  * The cross-reference section for this function's
  * documentation should ideally contain every
  * callback, but the list would be tediously long and
  * prone to omissions.
  *
- * \see glutMainLoopEvent(), glutLeaveMainLoop(), glutIdleFunc()
+ * \see glutMainLoopEvent(), glutLeaveMainLoop(), glutIdleFunc(),
+ *      glutSetOption()
  */
 void glutMainLoop(void)
 {
@@ -147,7 +326,8 @@ void glutMainLoop(void)
  *       GtkGLUT to do its work in a batch, then return to whatever
  *       processing the other library (or libraries) require.
  *
- * \see glutIdleFunc(), glutLeaveMainLoop(), glutMainLoop()
+ * \see glutIdleFunc(), glutLeaveMainLoop(), glutMainLoop(),
+ *      glutMainLoopEventBudget()
  */
 void glutMainLoopEvent(void)
 {
@@ -156,6 +336,94 @@ void glutMainLoopEvent(void)
 	gtk_main_iteration_do(FALSE);
 }
 
+/*
+ * Return microseconds till pending redisplay is executed (0 if it's ready) or -1
+ * if there is no pending redisplay
+ */
+static gint64 __gtkglut_next_redisplay(void)
+{
+	gint64 remaining;
+
+	if (__gtkglut_context->dirty_windows->len == 0)
+		return -1;
+
+	if (__gtkglut_context->frame_period <= 0)
+		return 0;
+
+	remaining = __gtkglut_context->frame_deadline - __gtkglut_get_time_usec();
+
+	return (remaining < 0) ? 0 : remaining;
+}
+
+/*!
+ * \brief    Dispatches pending events within given budget.
+ * \ingroup  mainloop
+ * \param    budget_usec    Maximal time spent in function in microseconds,
+ *                          0 for no limit.
+ * \param    max_events     Maximal number of main loop iterations, 0 for
+ *                          no limit.
+ * \param    stats          Statistics, filled on return. Can be NULL.
+ *
+ * Repeatedly runs one main loop iteration without blocking, until
+ * nothing is pending (GTK+ events, expired timers, posted redisplays,
+ * idle callback, ...) or one of limits is reached.  Budget is checked
+ * before every iteration, so one long callback can exceed it.
+ *
+ * \a stats are filled with:
+ * - \a events - number of iterations, which dispatched something.
+ *   One iteration dispatches one GTK+ event, or all expired timers,
+ *   or all posted redisplays.
+ * - \a elapsed - microseconds spent in function.
+ * - \a next_timer - microseconds till function should be called again
+ *   to run timers (0 if timer is already expired), -1 if there is no
+ *   timer.
+ * - \a next_redisplay - microseconds till posted redisplay can be
+ *   executed (frame deadline of paced main loop), -1 if there is no
+ *   posted redisplay.
+ *
+ * This allows host application to interleave GtkGLUT with its own
+ * work and to sleep exactly till GtkGLUT needs to be called again.
+ *
+ * \note If idle callback with default policy is registered, something
+ *       is always pending, so call this function with some limit.
+ *
+ * \return   Number of iterations, which dispatched something.
+ * \see glutMainLoopEvent(), glutIdleFunc(), glutSetOption()
+ */
+int glutMainLoopEventBudget(GLUTint64 budget_usec, int max_events, GLUTloopStats * stats)
+{
+	gint64 start;
+	gint64 elapsed;
+	int events;
+
+	__gtkglut_test_inicialization("glutMainLoopEventBudget");
+
+	start = __gtkglut_get_time_nsec() / 1000;
+	elapsed = 0;
+	events = 0;
+
+	while (max_events <= 0 || events < max_events) {
+		if (budget_usec > 0 && elapsed >= budget_usec)
+			break;
+
+		if (!g_main_context_iteration(NULL, FALSE))
+			break;
+
+		events++;
+
+		elapsed = __gtkglut_get_time_nsec() / 1000 - start;
+	}
+
+	if (stats) {
+		stats->events = events;
+		stats->elapsed = __gtkglut_get_time_nsec() / 1000 - start;
+		stats->next_timer = __gtkglut_timer_next_wakeup();
+		stats->next_redisplay = __gtkglut_next_redisplay();
+	}
+
+	return events;
+}
+
 /*!
  * \brief    Breaks out of GtkGLUT's glutMainLoop()
  * \ingroup  mainloop
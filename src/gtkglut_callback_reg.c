@@ -40,16 +40,132 @@
  */
 
 /*
- * GTK handler for idle callback
+ * Return TRUE, if at least one window is visible (window with unknown
+ * visibility is counted as visible)
  */
-gboolean __gtkglut_callback_idle_handler(gpointer data)
+static gboolean __gtkglut_idle_any_window_visible(void)
 {
+	__gtkglut_window_struct *glut_window;
+	guint i;
+
+	if (!__gtkglut_context->window_array)
+		return FALSE;
+
+	for (i = 0; i < __gtkglut_context->window_array->len; i++) {
+		glut_window = (__gtkglut_window_struct *)
+		    g_ptr_array_index(__gtkglut_context->window_array, i);
+
+		if (glut_window && glut_window->window_visible != FALSE && !glut_window->iconified)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*
+ * Return period of idle callback for GTKGLUT_IDLE_ONCE_PER_FRAME policy in
+ * microseconds. Frame rate of paced main loop is used, or 60 Hz if main loop
+ * is not paced.
+ */
+static gint64 __gtkglut_idle_period(void)
+{
+
+	if (__gtkglut_context->frame_period > 0)
+		return __gtkglut_context->frame_period;
+
+	return G_USEC_PER_SEC / 60;
+}
+
+/*
+ * Idle source. It's ready when idle callback is registered and idle policy
+ * allows to call it. Otherwise main loop can sleep.
+ */
+static gboolean __gtkglut_idle_source_prepare(GSource * source, gint * timeout)
+{
+	gint64 remaining;
+
+	*timeout = -1;
+
+	if (!__gtkglut_context->callback_idle)
+		return FALSE;
+
+	switch (__gtkglut_context->idle_policy) {
+	case GTKGLUT_IDLE_ONCE_PER_FRAME:
+		remaining = __gtkglut_context->idle_deadline - __gtkglut_get_time_usec();
+
+		if (remaining <= 0)
+			return TRUE;
+
+		*timeout = (gint) ((remaining + 999) / 1000);
+
+		return FALSE;
+		break;
+
+	case GTKGLUT_IDLE_WHEN_VISIBLE:
+		/*
+		 * Visibility changes come as GDK events, which wake main loop up
+		 */
+		return __gtkglut_idle_any_window_visible();
+		break;
+	}
+
+	return TRUE;
+}
+
+static gboolean __gtkglut_idle_source_check(GSource * source)
+{
+	gint timeout;
+
+	return __gtkglut_idle_source_prepare(source, &timeout);
+}
+
+static gboolean __gtkglut_idle_source_dispatch(GSource * source, GSourceFunc callback,
+					       gpointer user_data)
+{
+	gint64 now;
+
+	if (__gtkglut_context->idle_policy == GTKGLUT_IDLE_ONCE_PER_FRAME) {
+		now = __gtkglut_get_time_usec();
+
+		__gtkglut_context->idle_deadline += __gtkglut_idle_period();
+
+		if (__gtkglut_context->idle_deadline <= now)
+			__gtkglut_context->idle_deadline = now + __gtkglut_idle_period();
+	}
+
 	if (__gtkglut_context->callback_idle)
 		__gtkglut_context->callback_idle();
 
 	return TRUE;
 }
 
+static GSourceFuncs __gtkglut_idle_source_funcs = {
+	__gtkglut_idle_source_prepare,
+	__gtkglut_idle_source_check,
+	__gtkglut_idle_source_dispatch,
+	NULL
+};
+
+/*
+ * Set policy of idle callback
+ */
+void __gtkglut_set_idle_policy(int policy)
+{
+
+	switch (policy) {
+	case GTKGLUT_IDLE_ALWAYS:
+	case GTKGLUT_IDLE_ONCE_PER_FRAME:
+	case GTKGLUT_IDLE_WHEN_VISIBLE:
+		__gtkglut_context->idle_policy = policy;
+		__gtkglut_context->idle_deadline = __gtkglut_get_time_usec();
+		break;
+
+	default:
+		__gtkglut_warning("glutSetOption", "Unknown idle policy %d.", policy);
+		break;
+	}
+}
+
 /*!
  * \brief    Sets the global idle callback.
  * \ingroup  idletimer
@@ -59,44 +175,33 @@ gboolean __gtkglut_callback_idle_handler(gpointer data)
  * it checks to see if an ``idle'' callback set.
  * If so, GtkGLUT invokes that callback.
  *
+ * How often idle callback is called can be changed by
+ * \a GTKGLUT_IDLE_POLICY option of glutSetOption().
+ * By default, it's called in every main loop iteration.
+ *
  * This callback is *not* bound to any window.
  *
  * \note There is at most **one** idle callback for your entire
  *       application.
  *
- * \see glutTimerFunc(), glutMainLoop(), glutMainLoopEvent()
+ * \see glutTimerFunc(), glutMainLoop(), glutMainLoopEvent(),
+ *      glutSetOption()
  */
 void glutIdleFunc(void (*func) (void))
 {
 	__gtkglut_test_inicialization("glutIdleFunc");
 
-	if (__gtkglut_context->callback_idle) {
-		if (!g_idle_remove_by_data((void *)__gtkglut_context->callback_idle)) {
-			__gtkglut_error("glutIdleFunc",
-					"Internal error. Cannot remove idle handler!");
-		}
+	if (func && !__gtkglut_context->idle_source) {
+		/*
+		 * Same priority as g_idle_add
+		 */
+		__gtkglut_context->idle_source =
+		    g_source_new(&__gtkglut_idle_source_funcs, sizeof(GSource));
+		g_source_set_priority(__gtkglut_context->idle_source, G_PRIORITY_DEFAULT_IDLE);
+		g_source_attach(__gtkglut_context->idle_source, NULL);
 	}
 
 	__gtkglut_context->callback_idle = func;
-
-	if (func)
-		g_idle_add(__gtkglut_callback_idle_handler, (void *)func);
-}
-
-/*
- * Internal handler of GTK timer events.
- */
-gboolean __gtkglut_callback_timer_handler(gpointer data)
-{
-	__gtkglut_timer_callback_struct *timerData;
-
-	timerData = (__gtkglut_timer_callback_struct *) data;
-
-	timerData->func(timerData->value);
-
-	free(timerData);
-
-	return FALSE;
 }
 
 /*!
@@ -116,31 +221,22 @@ gboolean __gtkglut_callback_timer_handler(gpointer data)
  * \note Unlike most other callbacks, timers only occur once.
  *
  * \note Unlike most other callbacks, you cannot deregister a
- *       timer callback.
+ *       timer callback.  Use glutAddTimer() if you need to cancel
+ *       timer.
  *
  * \note Unlike most other callbacks, you can register an
  *       arbitrary number of timers.
  *
- * \see glutIdleFunc(), glutMainLoop(), glutMainLoopEvent()
+ * \see glutIdleFunc(), glutMainLoop(), glutMainLoopEvent(), glutAddTimer()
  */
 void glutTimerFunc(unsigned int msecs, void (*func) (int value), int value)
 {
-	__gtkglut_timer_callback_struct *timerData;
-
 	__gtkglut_test_inicialization("glutTimerFunc");
 
 	if (func == NULL) {
 		__gtkglut_warning("glutTimerFunc", "Registering NULL callback doesn't make sense.");
-	} else {
-		timerData = (__gtkglut_timer_callback_struct *)
-		    malloc(sizeof(__gtkglut_timer_callback_struct));
-
-		if (timerData == NULL)
-			__gtkglut_lowmem();
-
-		timerData->value = value;
-		timerData->func = func;
-		g_timeout_add(msecs, __gtkglut_callback_timer_handler, timerData);
+	} else if (!__gtkglut_timer_add(msecs, 0, func, value)) {
+		__gtkglut_warning("glutTimerFunc", "Too many active timers.");
 	}
 }
 
@@ -248,6 +344,176 @@ void glutReshapeFunc(void (*func) (int width, int height))
 	}
 }
 
+/*
+ * GTK+ signal emitted for event type, NULL if event has no own signal
+ */
+static const char *__gtkglut_event_signal_name(int type)
+{
+	switch (type) {
+	case GDK_KEY_PRESS:
+		return "key-press-event";
+	case GDK_KEY_RELEASE:
+		return "key-release-event";
+	case GDK_BUTTON_PRESS:
+		return "button-press-event";
+	case GDK_BUTTON_RELEASE:
+		return "button-release-event";
+	case GDK_SCROLL:
+		return "scroll-event";
+	case GDK_MOTION_NOTIFY:
+		return "motion-notify-event";
+	case GDK_VISIBILITY_NOTIFY:
+		return "visibility-notify-event";
+	case GDK_ENTER_NOTIFY:
+		return "enter-notify-event";
+	case GDK_LEAVE_NOTIFY:
+		return "leave-notify-event";
+	}
+
+	return NULL;
+}
+
+/*
+ * Add event mask to drawing area, only first time
+ */
+static void __gtkglut_window_add_events(__gtkglut_window_struct * glut_window,
+					__gtkglut_signal_struct * signal, gint events)
+{
+	if (!signal->event_added) {
+		signal->event_added = TRUE;
+
+		gtk_widget_add_events(glut_window->drawing_area, events);
+	}
+}
+
+/*
+ * Rebuild event table of window from registered callbacks and add event masks.
+ * Event dispatcher calls handlers straight from table. GTK+ signals are connected
+ * for table entries only if dispatcher is disabled.
+ */
+void __gtkglut_window_events_update(__gtkglut_window_struct * glut_window, int window_id)
+{
+	__gtkglut_event_func *table;
+	gboolean keyboard, keyboard_up, mouse, motion, visibility, needed;
+	const char *name;
+	int i;
+
+	table = glut_window->event_table;
+
+	keyboard = glut_window->signal_keyboard.glut_callback_handler ||
+	    glut_window->signal_keyboard_special.glut_callback_handler;
+
+	keyboard_up = glut_window->signal_keyboard_up.glut_callback_handler ||
+	    glut_window->signal_keyboard_special_up.glut_callback_handler;
+
+	mouse = (glut_window->signal_mouse_press.glut_callback_handler != NULL);
+	for (i = 0; i < __GTKGLUT_MAX_MOUSE_BUTTONS; i++)
+		if (glut_window->mouse_button_menu[i])
+			mouse = TRUE;
+
+	/*
+	 * Motion events are also needed for pointer cache of keyboard callbacks
+	 */
+	motion = glut_window->signal_motion.glut_callback_handler ||
+	    glut_window->signal_passive_motion.glut_callback_handler ||
+	    glut_window->signal_motion_history.glut_callback_handler ||
+	    (__gtkglut_context->pointer_cache && (keyboard || keyboard_up));
+
+	/*
+	 * Visibility is needed by visibility and status callbacks and for skipping
+	 * redisplay of hidden windows
+	 */
+	visibility = glut_window->signal_visibility.glut_callback_handler ||
+	    glut_window->signal_status.glut_callback_handler ||
+	    __gtkglut_context->skip_hidden_redisplay;
+
+	if (motion && !table[GDK_MOTION_NOTIFY]) {
+		/*
+		 * Pointer may have moved while we weren't listening
+		 */
+		glut_window->pointer_valid = FALSE;
+	} else if (!motion && table[GDK_MOTION_NOTIFY]) {
+		/*
+		 * Deliver what we have
+		 */
+		__gtkglut_flush_window_motion(window_id);
+	}
+
+	for (i = 0; i < __GTKGLUT_EVENT_TABLE_SIZE; i++)
+		table[i] = NULL;
+
+	table[GDK_ENTER_NOTIFY] = table[GDK_LEAVE_NOTIFY] =
+	    (__gtkglut_event_func) glut_window->signal_entry.gtk_event_handler;
+
+	if (keyboard) {
+		__gtkglut_window_add_events(glut_window, &glut_window->signal_keyboard,
+					    GDK_KEY_PRESS_MASK);
+		table[GDK_KEY_PRESS] =
+		    (__gtkglut_event_func) glut_window->signal_keyboard.gtk_event_handler;
+	}
+
+	if (keyboard_up) {
+		__gtkglut_window_add_events(glut_window, &glut_window->signal_keyboard_up,
+					    GDK_KEY_RELEASE_MASK);
+		table[GDK_KEY_RELEASE] =
+		    (__gtkglut_event_func) glut_window->signal_keyboard_up.gtk_event_handler;
+	}
+
+	if (mouse || glut_window->signal_mouse_wheel.glut_callback_handler)
+		__gtkglut_window_add_events(glut_window, &glut_window->signal_mouse_press,
+					    GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK);
+
+	if (mouse) {
+		/*
+		 * Double and triple clicks go to press handler, which ignores them
+		 */
+		table[GDK_BUTTON_PRESS] = table[GDK_2BUTTON_PRESS] = table[GDK_3BUTTON_PRESS] =
+		    (__gtkglut_event_func) glut_window->signal_mouse_press.gtk_event_handler;
+		table[GDK_BUTTON_RELEASE] =
+		    (__gtkglut_event_func) glut_window->signal_mouse_release.gtk_event_handler;
+	}
+
+	if (glut_window->signal_mouse_wheel.glut_callback_handler)
+		table[GDK_SCROLL] =
+		    (__gtkglut_event_func) glut_window->signal_mouse_wheel.gtk_event_handler;
+
+	if (motion) {
+		__gtkglut_window_add_events(glut_window, &glut_window->signal_motion,
+					    GDK_POINTER_MOTION_MASK);
+		table[GDK_MOTION_NOTIFY] =
+		    (__gtkglut_event_func) glut_window->signal_motion.gtk_event_handler;
+	}
+
+	if (visibility) {
+		__gtkglut_window_add_events(glut_window, &glut_window->signal_visibility,
+					    GDK_VISIBILITY_NOTIFY_MASK);
+		table[GDK_VISIBILITY_NOTIFY] =
+		    (__gtkglut_event_func) glut_window->signal_visibility.gtk_event_handler;
+	}
+
+	/*
+	 * Without event dispatcher, events come through GTK+ signals
+	 */
+	for (i = 0; i < __GTKGLUT_EVENT_TABLE_SIZE; i++) {
+		name = __gtkglut_event_signal_name(i);
+
+		if (!name)
+			continue;
+
+		needed = table[i] && !__gtkglut_context->event_dispatch;
+
+		if (needed && !glut_window->event_signal[i]) {
+			glut_window->event_signal[i] =
+			    g_signal_connect(G_OBJECT(glut_window->drawing_area), name,
+					     G_CALLBACK(table[i]), GINT_TO_POINTER(window_id));
+		} else if (!needed && glut_window->event_signal[i]) {
+			g_signal_handler_disconnect(G_OBJECT(glut_window->drawing_area),
+						    glut_window->event_signal[i]);
+			glut_window->event_signal[i] = 0;
+		}
+	}
+}
+
 /*
  * Internal registration function for callbacks glutVisibilityFunc and glutWindowStatusFunc.
  */
@@ -261,51 +527,18 @@ void __gtkglut_state_func(char *func_name, void (*func) (int state), gboolean st
 
 	if (glut_window) {
 		if (func) {
-			/*User want register callback */
-			if (!glut_window->signal_visibility.event_added) {
-				glut_window->signal_visibility.event_added =
-				    glut_window->signal_status.event_added = TRUE;
-				gtk_widget_add_events(glut_window->drawing_area,
-						      GDK_VISIBILITY_NOTIFY_MASK);
-			}
-
-			if (!glut_window->signal_visibility.glut_callback_handler
-			    && !glut_window->signal_status.glut_callback_handler) {
-				/*Noone have registered callback, register */
-				glut_window->signal_visibility.signal_id =
-				    g_signal_connect(G_OBJECT
-						     (glut_window->drawing_area),
-						     "visibility_notify_event",
-						     G_CALLBACK
-						     (glut_window->signal_visibility.
-						      gtk_event_handler),
-						     GINT_TO_POINTER(glutGetWindow()));
-
-				glut_window->signal_status.signal_id =
-				    glut_window->signal_visibility.signal_id;
-			}
-
 			if (status_event)
 				glut_window->window_visible = __GTKGLUT_UNDEFINED;
 			else
 				glut_window->window_status = __GTKGLUT_UNDEFINED;
-		} else {
-			if ((status_event && glut_window->signal_status.glut_callback_handler
-			    && !glut_window->signal_visibility.glut_callback_handler)
-			    || (!status_event && !glut_window->signal_status.glut_callback_handler
-				&& glut_window->signal_visibility.glut_callback_handler)) {
-				/*We can deregister */
-				g_signal_handler_disconnect(G_OBJECT
-							    (glut_window->drawing_area),
-							    glut_window->signal_visibility.
-							    signal_id);
-			}
 		}
 
 		if (!status_event)
 			glut_window->signal_visibility.glut_callback_handler = (void *)func;
 		else
 			glut_window->signal_status.glut_callback_handler = (void *)func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -369,7 +602,6 @@ void glutWindowStatusFunc(void (*func) (int state))
 
 /*
  * Function register callback. This is used by glut(Keyboard|Special)[Up]Func.
- * It's little messy, but I hope works well.
  */
 void __gtkglut_keyboard_func(char *func_name, gboolean up, gboolean special, void *func)
 {
@@ -380,114 +612,17 @@ void __gtkglut_keyboard_func(char *func_name, gboolean up, gboolean special, voi
 	glut_window = __gtkglut_get_active_window_with_warning(func_name);
 
 	if (glut_window) {
-		/*We have window */
-		if (func) {
-			/*User want register some function */
-			if (up) {
-				/*We registering UP function */
-
-				/*
-				 * Test, if event is added. This is only for first time.
-				 * SpecialUP and KeyboardUP share one variable
-				 */
-				if (!glut_window->signal_keyboard_up.event_added) {
-					/*Register event for key release */
-					glut_window->signal_keyboard_up.event_added =
-					    glut_window->signal_keyboard_special_up.event_added =
-					    TRUE;
-					gtk_widget_add_events(glut_window->drawing_area,
-							      GDK_KEY_RELEASE_MASK);
-				}
-
-				/*If no one have registered function, we must register it */
-				if (!glut_window->signal_keyboard_up.glut_callback_handler
-				    && !glut_window->signal_keyboard_special_up.
-				    glut_callback_handler) {
-					/*We must register callback */
-					glut_window->signal_keyboard_up.signal_id =
-					    g_signal_connect(G_OBJECT
-							     (glut_window->drawing_area),
-							     "key-release-event",
-							     G_CALLBACK
-							     (glut_window->signal_keyboard_up.
-							      gtk_event_handler),
-							     GINT_TO_POINTER(glutGetWindow()));
-				}
-			} else {
-				/*We registering NOT UP Function */
-
-				/*Same as for UP */
-				if (!glut_window->signal_keyboard.event_added) {
-					/*Register event for key press */
-					glut_window->signal_keyboard.event_added =
-					    glut_window->signal_keyboard_special.event_added = TRUE;
-					gtk_widget_add_events(glut_window->drawing_area,
-							      GDK_KEY_PRESS_MASK);
-				}
-
-				/*Same as for UP */
-				if (!glut_window->signal_keyboard.glut_callback_handler
-				    && !glut_window->signal_keyboard_special.
-				    glut_callback_handler) {
-					/*We must register callback */
-					glut_window->signal_keyboard.signal_id =
-					    g_signal_connect(G_OBJECT
-							     (glut_window->drawing_area),
-							     "key-press-event",
-							     G_CALLBACK
-							     (glut_window->signal_keyboard.
-							      gtk_event_handler),
-							     GINT_TO_POINTER(glutGetWindow()));
-				}
-			}
-		} else {
-			/*We deregistering function */
-			if (up) {
-				/*We deregistering UP function */
-
-				/*Test, if there is nobody, who cares on signal */
-				if ((special
-				     && !glut_window->signal_keyboard_up.glut_callback_handler
-				     && glut_window->signal_keyboard_special_up.
-				     glut_callback_handler) || (!special
-								&& glut_window->signal_keyboard_up.
-								glut_callback_handler
-								&& !glut_window->
-								signal_keyboard_special_up.
-								glut_callback_handler)) {
-					g_signal_handler_disconnect(G_OBJECT
-								    (glut_window->drawing_area),
-								    glut_window->signal_keyboard_up.
-								    signal_id);
-				}
-			} else {
-				/*We deregistering NOT UP function */
-
-				/*Test, if there is nobody, who cares on signal */
-				if ((special
-				     && glut_window->signal_keyboard_special.glut_callback_handler
-				     && !glut_window->signal_keyboard.glut_callback_handler)
-				    || (!special
-					&&
-					!glut_window->signal_keyboard_special.glut_callback_handler
-					&& glut_window->signal_keyboard.glut_callback_handler)) {
-					g_signal_handler_disconnect(G_OBJECT
-								    (glut_window->drawing_area),
-								    glut_window->signal_keyboard.
-								    signal_id);
-				}
-			}
-		}
+		if (up && special)
+			glut_window->signal_keyboard_special_up.glut_callback_handler = func;
+		if (up && !special)
+			glut_window->signal_keyboard_up.glut_callback_handler = func;
+		if (!up && special)
+			glut_window->signal_keyboard_special.glut_callback_handler = func;
+		if (!up && !special)
+			glut_window->signal_keyboard.glut_callback_handler = func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
-
-	if (up && special)
-		glut_window->signal_keyboard_special_up.glut_callback_handler = func;
-	if (up && !special)
-		glut_window->signal_keyboard_up.glut_callback_handler = func;
-	if (!up && special)
-		glut_window->signal_keyboard_special.glut_callback_handler = func;
-	if (!up && !special)
-		glut_window->signal_keyboard.glut_callback_handler = func;
 }
 
 /*!
@@ -609,83 +744,6 @@ void glutSpecialUpFunc(void (*func) (int key, int x, int y))
 	__gtkglut_keyboard_func("glutSpecialUpFunc", TRUE, TRUE, (void *)func);
 }
 
-/*
- * Mouse button registration
- */
-void __gtkglut_register_mouse_func(__gtkglut_window_struct * glut_window)
-{
-	int i;
-	gboolean signal_added;
-
-	/*User want register callback */
-	if (!glut_window->signal_mouse_press.event_added) {
-		glut_window->signal_mouse_press.event_added =
-		    glut_window->signal_mouse_release.event_added =
-		    glut_window->signal_mouse_wheel.event_added = TRUE;
-
-		gtk_widget_add_events(glut_window->drawing_area,
-				      GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK);
-	}
-
-	/*Signal is active, if ... */
-	signal_added = FALSE;
-
-	/*... we have glut_window registered... */
-	if (glut_window->signal_mouse_press.glut_callback_handler)
-		signal_added = TRUE;
-	/*... or some mouse button for window is active */
-	for (i = 0; i < __GTKGLUT_MAX_MOUSE_BUTTONS; i++)
-		if (glut_window->mouse_button_menu[i])
-			signal_added = TRUE;
-
-	if (!signal_added) {
-/*    printf("MOUSE register signal!\n");*/
-		glut_window->signal_mouse_press.signal_id =
-		    g_signal_connect(G_OBJECT(glut_window->drawing_area),
-				     "button_press_event",
-				     G_CALLBACK(glut_window->signal_mouse_press.gtk_event_handler),
-				     GINT_TO_POINTER(glutGetWindow()));
-		glut_window->signal_mouse_release.signal_id =
-		    g_signal_connect(G_OBJECT(glut_window->drawing_area),
-				     "button_release_event",
-				     G_CALLBACK
-				     (glut_window->signal_mouse_release.gtk_event_handler),
-				     GINT_TO_POINTER(glutGetWindow()));
-	}
-}
-
-/*
- * Mouse button unregistration
- */
-void __gtkglut_unregister_mouse_func(__gtkglut_window_struct * glut_window, int menu_button)
-{
-	int i;
-	gboolean signal_unregister;
-
-	signal_unregister = TRUE;
-
-	/*User want unregister menu_button */
-
-	/*If other button than menu_button is registered, we can't unregister anything */
-	for (i = 0; i < __GTKGLUT_MAX_MOUSE_BUTTONS; i++)
-		if (glut_window->mouse_button_menu[i] && i != menu_button)
-			signal_unregister = FALSE;
-
-	/*If user have still explicit handler, we can't unregister anything */
-	if (menu_button != __GTKGLUT_UNDEFINED
-	    && glut_window->signal_mouse_press.glut_callback_handler)
-		signal_unregister = FALSE;
-
-	if (signal_unregister) {
-/*    printf("MOUSE Unregister signal!\n");*/
-		/*User want unregister callback */
-		g_signal_handler_disconnect(G_OBJECT(glut_window->drawing_area),
-					    glut_window->signal_mouse_press.signal_id);
-		g_signal_handler_disconnect(G_OBJECT(glut_window->drawing_area),
-					    glut_window->signal_mouse_release.signal_id);
-	}
-}
-
 /*!
  * \brief    Sets the mouse-button callback for the current window.
  * \ingroup  input
@@ -729,20 +787,10 @@ void glutMouseFunc(void (*func) (int button, int state, int x, int y))
 	glut_window = __gtkglut_get_active_window_with_warning("glutMouseFunc");
 
 	if (glut_window) {
-		if (glut_window->signal_mouse_press.glut_callback_handler) {
-			/*Some callback is registered */
-			if (!func) {
-				__gtkglut_unregister_mouse_func(glut_window, __GTKGLUT_UNDEFINED);
-			}
-		} else {
-			if (func) {
-				/*User want register callback */
-				__gtkglut_register_mouse_func(glut_window);
-			}
-		}
-
 		glut_window->signal_mouse_press.glut_callback_handler = (void *)func;
 		glut_window->signal_mouse_release.glut_callback_handler = (void *)func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -772,39 +820,9 @@ void glutMouseWheelFunc(void (*func) (int wheel, int direction, int x, int y))
 	glut_window = __gtkglut_get_active_window_with_warning("glutMouseWheelFunc");
 
 	if (glut_window) {
-		if (glut_window->signal_mouse_wheel.glut_callback_handler) {
-			/*Some callback is registered */
-			if (!func) {
-				/*User want unregister callback */
-				g_signal_handler_disconnect(G_OBJECT
-							    (glut_window->drawing_area),
-							    glut_window->signal_mouse_wheel.
-							    signal_id);
-			}
-		} else {
-			if (func) {
-				/*User want register callback */
-				if (!glut_window->signal_mouse_wheel.event_added) {
-					glut_window->signal_mouse_press.event_added =
-					    glut_window->signal_mouse_release.event_added =
-					    glut_window->signal_mouse_wheel.event_added = TRUE;
-
-					gtk_widget_add_events(glut_window->drawing_area,
-							      GDK_BUTTON_PRESS_MASK
-							      | GDK_BUTTON_RELEASE_MASK);
-				}
-				glut_window->signal_mouse_wheel.signal_id =
-				    g_signal_connect(G_OBJECT
-						     (glut_window->drawing_area),
-						     "scroll_event",
-						     G_CALLBACK
-						     (glut_window->signal_mouse_wheel.
-						      gtk_event_handler),
-						     GINT_TO_POINTER(glutGetWindow()));
-			}
-		}
-
 		glut_window->signal_mouse_wheel.glut_callback_handler = (void *)func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -821,47 +839,12 @@ void __gtkglut_mouse_motion_func(char *func_name, void *func, gboolean passive)
 	glut_window = __gtkglut_get_active_window_with_warning(func_name);
 
 	if (glut_window) {
-		if (!func) {
-			/*User want unregister callback */
-			if ((passive && glut_window->signal_passive_motion.glut_callback_handler
-			     && !glut_window->signal_motion.glut_callback_handler) ||
-			     (!passive && !glut_window->signal_passive_motion.glut_callback_handler &&
-			     glut_window->signal_motion. glut_callback_handler)) {
-				/*We can deregister */
-				g_signal_handler_disconnect(G_OBJECT
-							    (glut_window->drawing_area),
-							    glut_window->signal_motion.signal_id);
-			}
-		} else {
-			/*User want register callback */
-			if (!glut_window->signal_passive_motion.event_added
-			    && !glut_window->signal_motion.glut_callback_handler) {
-				glut_window->signal_passive_motion.event_added =
-				    glut_window->signal_motion.event_added = TRUE;
-
-				gtk_widget_add_events(glut_window->drawing_area,
-						      GDK_POINTER_MOTION_MASK);
-			}
-
-			if (!glut_window->signal_motion.glut_callback_handler
-			    && !glut_window->signal_passive_motion.glut_callback_handler) {
-				/*Noone have registered callback, register */
-				glut_window->signal_motion.signal_id =
-				    g_signal_connect(G_OBJECT
-						     (glut_window->drawing_area),
-						     "motion_notify_event",
-						     G_CALLBACK
-						     (glut_window->signal_motion.gtk_event_handler),
-						     GINT_TO_POINTER(glutGetWindow()));
-				glut_window->signal_passive_motion.signal_id =
-				    glut_window->signal_motion.signal_id;
-			}
-		}
-
 		if (!passive)
 			glut_window->signal_motion.glut_callback_handler = func;
 		else
 			glut_window->signal_passive_motion.glut_callback_handler = func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -908,6 +891,46 @@ void glutPassiveMotionFunc(void (*func) (int x, int y))
 	__gtkglut_mouse_motion_func("glutPassiveMotionFunc", (void *)func, TRUE);
 }
 
+/*!
+ * \brief    Sets the mouse motion history callback.
+ * \ingroup  input
+ * \param    func    Client hook for motion history.
+ *
+ * The callback receives all motion samples (position and time
+ * of event in milliseconds) collected since last call in
+ * one array.  \a state is \a GLUT_DOWN if some mouse button
+ * was held during motion (active motion), otherwise \a GLUT_UP.
+ * Active and passive motion is never reported in one call.
+ *
+ * This is useful together with motion compression (see
+ * glutSetOption() and \a GTKGLUT_MOTION_COMPRESSION).  Motion
+ * and passive motion callbacks are then called only with last
+ * position once per main loop iteration, but the history callback
+ * still gets every sample.  Without compression, history callback
+ * is called with one sample for every motion event.
+ *
+ * The history callback is called before motion or passive
+ * motion callback.
+ *
+ * This callback is bound to the *current window*.
+ *
+ * \see glutMotionFunc(), glutPassiveMotionFunc(), glutSetOption()
+ */
+void glutMotionHistoryFunc(void (*func) (int state, int count, const GLUTmotionSample * samples))
+{
+	__gtkglut_window_struct *glut_window;
+
+	__gtkglut_test_inicialization("glutMotionHistoryFunc");
+
+	glut_window = __gtkglut_get_active_window_with_warning("glutMotionHistoryFunc");
+
+	if (glut_window) {
+		glut_window->signal_motion_history.glut_callback_handler = (void *)func;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
+	}
+}
+
 /*!
  * \brief    Window mouse entry/leave callback.
  * \ingroup  input
@@ -931,33 +954,10 @@ void glutEntryFunc(void (*func) (int state))
 
 	glut_window = __gtkglut_get_active_window_with_warning("glutEntryFunc");
 
+	/*
+	 * Enter and leave signals are connected, when window is created
+	 */
 	if (glut_window) {
-		if (glut_window->signal_entry.glut_callback_handler) {
-			/*Some callback is registered */
-			if (!func) {
-				/*User want unregister callback */
-				g_signal_handler_disconnect(G_OBJECT
-							    (glut_window->drawing_area),
-							    glut_window->signal_entry.signal_id);
-			}
-		} else {
-			if (func) {
-				/*User want register callback */
-				if (!glut_window->signal_entry.event_added) {
-					glut_window->signal_entry.event_added = TRUE;
-					gtk_widget_add_events(glut_window->drawing_area,
-							      GDK_LEAVE_NOTIFY_MASK);
-				}
-				glut_window->signal_entry.signal_id =
-				    g_signal_connect(G_OBJECT
-						     (glut_window->drawing_area),
-						     "leave_notify_event",
-						     G_CALLBACK
-						     (glut_window->signal_entry.gtk_event_handler),
-						     GINT_TO_POINTER(glutGetWindow()));
-			}
-		}
-
 		glut_window->signal_entry.glut_callback_handler = (void *)func;
 	}
 
@@ -183,6 +183,28 @@ GLUTproc __gtkglut_get_proc_address(const char *proc_name)
 	__GTKGLUT_CHECK_NAME(glutSolidCylinder);
 	__GTKGLUT_CHECK_NAME(glutGetProcAddress);
 	__GTKGLUT_CHECK_NAME(glutMouseWheelFunc);
+	__GTKGLUT_CHECK_NAME(glutMotionHistoryFunc);
+	__GTKGLUT_CHECK_NAME(glutAddTimer);
+	__GTKGLUT_CHECK_NAME(glutCancelTimer);
+	__GTKGLUT_CHECK_NAME(glutAddTimerUsec);
+	__GTKGLUT_CHECK_NAME(glutGet64);
+	__GTKGLUT_CHECK_NAME(glutThreadPostWindowRedisplay);
+	__GTKGLUT_CHECK_NAME(glutThreadPostTask);
+	__GTKGLUT_CHECK_NAME(glutMainLoopEventBudget);
+	__GTKGLUT_CHECK_NAME(glutGetv);
+	__GTKGLUT_CHECK_NAME(glutSwapInterval);
+	__GTKGLUT_CHECK_NAME(glutGetFrameStats);
+	__GTKGLUT_CHECK_NAME(glutResetFrameStats);
+	__GTKGLUT_CHECK_NAME(glutSolidSphereInstanced);
+	__GTKGLUT_CHECK_NAME(glutWireSphereInstanced);
+	__GTKGLUT_CHECK_NAME(glutSolidCubeInstanced);
+	__GTKGLUT_CHECK_NAME(glutWireCubeInstanced);
+	__GTKGLUT_CHECK_NAME(glutSolidConeInstanced);
+	__GTKGLUT_CHECK_NAME(glutWireConeInstanced);
+	__GTKGLUT_CHECK_NAME(glutSolidTorusInstanced);
+	__GTKGLUT_CHECK_NAME(glutWireTorusInstanced);
+	__GTKGLUT_CHECK_NAME(glutSolidCylinderInstanced);
+	__GTKGLUT_CHECK_NAME(glutWireCylinderInstanced);
 #undef __GTKGLUT_CHECK_NAME
 
 	return NULL;
@@ -96,6 +96,102 @@ int __gtkglut_gl_config_make_format_id(__gtkglut_window_struct * glut_window)
 
 }
 
+/*
+ * Read all framebuffer attributes of window. GdkGLConfig of window never
+ * changes, so it's done only once, when window is created.
+ */
+void __gtkglut_fb_config_snapshot(__gtkglut_window_struct * glut_window)
+{
+	__gtkglut_fb_config_struct *fb;
+
+	fb = &glut_window->fb_config;
+
+	fb->buffer_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_BUFFER_SIZE);
+	fb->stencil_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_STENCIL_SIZE);
+	fb->depth_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_DEPTH_SIZE);
+	fb->red_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_RED_SIZE);
+	fb->green_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_GREEN_SIZE);
+	fb->blue_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_BLUE_SIZE);
+	fb->alpha_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ALPHA_SIZE);
+	fb->accum_red_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_RED_SIZE);
+	fb->accum_green_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_GREEN_SIZE);
+	fb->accum_blue_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_BLUE_SIZE);
+	fb->accum_alpha_size = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_ALPHA_SIZE);
+	fb->num_samples = __gtkglut_gl_config_attrib(glut_window, GDK_GL_SAMPLE_BUFFERS);
+	fb->doublebuffer = __gtkglut_gl_config_attrib(glut_window, GDK_GL_DOUBLEBUFFER) ? 1 : 0;
+	fb->rgba = __gtkglut_gl_config_attrib(glut_window, GDK_GL_RGBA) ? 1 : 0;
+	fb->stereo = __gtkglut_gl_config_attrib(glut_window, GDK_GL_STEREO) ? 1 : 0;
+	fb->format_id = __gtkglut_gl_config_make_format_id(glut_window);
+}
+
+/*
+ * Get framebuffer attribute of window from snapshot. Returns FALSE, if state is
+ * not framebuffer attribute.
+ */
+static gboolean __gtkglut_fb_config_get(__gtkglut_window_struct * glut_window, GLenum state,
+					int *res)
+{
+	__gtkglut_fb_config_struct *fb;
+
+	fb = &glut_window->fb_config;
+
+	switch (state) {
+	case GLUT_WINDOW_BUFFER_SIZE:
+		*res = fb->buffer_size;
+		break;
+	case GLUT_WINDOW_STENCIL_SIZE:
+		*res = fb->stencil_size;
+		break;
+	case GLUT_WINDOW_DEPTH_SIZE:
+		*res = fb->depth_size;
+		break;
+	case GLUT_WINDOW_RED_SIZE:
+		*res = fb->red_size;
+		break;
+	case GLUT_WINDOW_GREEN_SIZE:
+		*res = fb->green_size;
+		break;
+	case GLUT_WINDOW_BLUE_SIZE:
+		*res = fb->blue_size;
+		break;
+	case GLUT_WINDOW_ALPHA_SIZE:
+		*res = fb->alpha_size;
+		break;
+	case GLUT_WINDOW_ACCUM_RED_SIZE:
+		*res = fb->accum_red_size;
+		break;
+	case GLUT_WINDOW_ACCUM_GREEN_SIZE:
+		*res = fb->accum_green_size;
+		break;
+	case GLUT_WINDOW_ACCUM_BLUE_SIZE:
+		*res = fb->accum_blue_size;
+		break;
+	case GLUT_WINDOW_ACCUM_ALPHA_SIZE:
+		*res = fb->accum_alpha_size;
+		break;
+	case GLUT_WINDOW_NUM_SAMPLES:
+		*res = fb->num_samples;
+		break;
+	case GLUT_WINDOW_DOUBLEBUFFER:
+		*res = fb->doublebuffer;
+		break;
+	case GLUT_WINDOW_RGBA:
+		*res = fb->rgba;
+		break;
+	case GLUT_WINDOW_STEREO:
+		*res = fb->stereo;
+		break;
+	case GLUT_WINDOW_FORMAT_ID:
+		*res = fb->format_id;
+		break;
+	default:
+		return FALSE;
+		break;
+	}
+
+	return TRUE;
+}
+
 /*!
  * \defgroup inputstate Input State
  */
@@ -144,7 +240,8 @@ int __gtkglut_gl_config_make_format_id(__gtkglut_window_struct * glut_window)
  * - \a GLUT_MENU_NUM_ITEMS
  *
  * - \a GLUT_RENDERING_CONTEXT \n
- *      OpenGL contexts shared with new windows.
+ *      \a GLUT_USE_CURRENT_CONTEXT if OpenGL context of new windows
+ *      is shared with current window, otherwise \a GLUT_CREATE_NEW_CONTEXT.
  *
  * - \a GLUT_SCREEN_HEIGHT \n
  *      Screen height in pixels.
@@ -161,6 +258,55 @@ int __gtkglut_gl_config_make_format_id(__gtkglut_window_struct * glut_window)
  * - \a GLUT_VERSION \n
  *      Emulate Freeglut
  *
+ * - \a GTKGLUT_CONTEXT_SWITCHES \n
+ *      Number of OpenGL context switches done by glutSetWindow(). Selecting
+ *      window, which is already current, doesn't switch context.
+ *
+ * - \a GTKGLUT_EVENT_DISPATCH \n
+ *      1 if input events are dispatched directly from GDK event handler
+ *
+ * - \a GTKGLUT_FRAME_DISPLAY_TIME \n
+ *      Average time spent in display callback of current window in
+ *      microseconds, -1 if there is no sample.  See glutGetFrameStats().
+ *
+ * - \a GTKGLUT_FRAME_GPU_TIME \n
+ *      Average GPU time of display callback of current window in
+ *      microseconds, -1 if there is no sample
+ *
+ * - \a GTKGLUT_FRAME_RATE \n
+ *      Frame rate of paced main loop, 0 if pacing is disabled
+ *
+ * - \a GTKGLUT_FRAME_STATS \n
+ *      1 if frame statistics are collected
+ *
+ * - \a GTKGLUT_FRAME_SWAP_INTERVAL \n
+ *      Average interval between buffer swaps of current window in
+ *      microseconds, -1 if there is no sample
+ *
+ * - \a GTKGLUT_GEOMETRY_CACHE \n
+ *      1 if window position and size are returned from cache
+ *
+ * - \a GTKGLUT_IDLE_POLICY \n
+ *      Policy of idle callback
+ *
+ * - \a GTKGLUT_MAX_FRAMES_IN_FLIGHT \n
+ *      Number of frames CPU can run ahead of GPU, 0 if not limited
+ *
+ * - \a GTKGLUT_MESH_CACHE_SIZE \n
+ *      Memory limit of mesh cache of built-in shapes in kilobytes
+ *
+ * - \a GTKGLUT_MOTION_COMPRESSION \n
+ *      1 if motion compression is enabled on current window
+ *
+ * - \a GTKGLUT_POINTER_CACHE \n
+ *      1 if keyboard callbacks get pointer position from cache
+ *
+ * - \a GTKGLUT_SKIP_HIDDEN_REDISPLAY \n
+ *      1 if display callback of hidden windows is skipped
+ *
+ * - \a GTKGLUT_TEAPOT_GRID \n
+ *      Number of divisions of Bezier patch of tessellated teapot
+ *
  * - \a GTKGLUT_VERSION \n
  *      Version of GtkGLUT
  *
@@ -262,6 +408,10 @@ int glutGet(GLenum state)
 		return __gtkglut_context->window_init_geometry.y;
 		break;
 
+	case GLUT_RENDERING_CONTEXT:
+		return __gtkglut_context->rendering_context;
+		break;
+
 	case GLUT_VERSION:
 		return 20400;
 		break;
@@ -270,6 +420,50 @@ int glutGet(GLenum state)
 		return __GTKGLUT_MAJOR_VERSION * 10000 + __GTKGLUT_MINOR_VERSION * 100 +
 		    __GTKGLUT_MICRO_VERSION;
 		break;
+
+	case GTKGLUT_FRAME_RATE:
+		return __gtkglut_context->frame_rate;
+		break;
+
+	case GTKGLUT_CONTEXT_SWITCHES:
+		return __gtkglut_context->gl_context_switches;
+		break;
+
+	case GTKGLUT_IDLE_POLICY:
+		return __gtkglut_context->idle_policy;
+		break;
+
+	case GTKGLUT_MAX_FRAMES_IN_FLIGHT:
+		return __gtkglut_context->max_frames_in_flight;
+		break;
+
+	case GTKGLUT_GEOMETRY_CACHE:
+		return __gtkglut_context->geometry_cache;
+		break;
+
+	case GTKGLUT_POINTER_CACHE:
+		return __gtkglut_context->pointer_cache;
+		break;
+
+	case GTKGLUT_EVENT_DISPATCH:
+		return __gtkglut_context->event_dispatch;
+		break;
+
+	case GTKGLUT_FRAME_STATS:
+		return __gtkglut_context->frame_stats;
+		break;
+
+	case GTKGLUT_MESH_CACHE_SIZE:
+		return (int)(__gtkglut_context->mesh_cache_limit / 1024);
+		break;
+
+	case GTKGLUT_SKIP_HIDDEN_REDISPLAY:
+		return __gtkglut_context->skip_hidden_redisplay;
+		break;
+
+	case GTKGLUT_TEAPOT_GRID:
+		return __gtkglut_context->teapot_grid;
+		break;
 	}
 
 	__gtkglut_test_inicialization("glutGet");
@@ -323,71 +517,43 @@ int glutGet(GLenum state)
 	case GLUT_WINDOW_STEREO:
 	case GLUT_WINDOW_CURSOR:
 	case GLUT_WINDOW_FORMAT_ID:
+	case GTKGLUT_MOTION_COMPRESSION:
+	case GTKGLUT_FRAME_DISPLAY_TIME:
+	case GTKGLUT_FRAME_SWAP_INTERVAL:
+	case GTKGLUT_FRAME_GPU_TIME:
 		glut_window = __gtkglut_get_active_window_with_warning("glutGet");
 
 		if (glut_window) {
-			if (state == GLUT_WINDOW_X) {
-				gdk_window_get_root_origin(glut_window->drawing_area->window, &x,
-							   &y);
-
-				res = x;
-			}
+			if (state == GLUT_WINDOW_X || state == GLUT_WINDOW_Y) {
+				if (!__gtkglut_context->geometry_cache
+				    || !glut_window->geometry_position_valid) {
+					gdk_window_get_root_origin(glut_window->drawing_area->window,
+								   &x, &y);
 
-			if (state == GLUT_WINDOW_Y) {
-				gdk_window_get_root_origin(glut_window->drawing_area->window, &x,
-							   &y);
+					__gtkglut_cache_window_position(glut_window, x, y);
+				}
 
-				res = y;
+				res = (state == GLUT_WINDOW_X) ?
+				    glut_window->geometry.x : glut_window->geometry.y;
 			}
 
-			if (state == GLUT_WINDOW_WIDTH) {
-				gdk_drawable_get_size(glut_window->drawing_area->window, &width,
-						      &height);
-
-				res = width;
-			}
+			if (state == GLUT_WINDOW_WIDTH || state == GLUT_WINDOW_HEIGHT) {
+				if (!__gtkglut_context->geometry_cache
+				    || !glut_window->geometry_size_valid) {
+					gdk_drawable_get_size(glut_window->drawing_area->window,
+							      &width, &height);
 
-			if (state == GLUT_WINDOW_HEIGHT) {
-				gdk_drawable_get_size(glut_window->drawing_area->window, &width,
-						      &height);
+					glut_window->geometry.width = width;
+					glut_window->geometry.height = height;
+					glut_window->geometry_size_valid = TRUE;
+				}
 
-				res = height;
+				res = (state == GLUT_WINDOW_WIDTH) ?
+				    glut_window->geometry.width : glut_window->geometry.height;
 			}
 
-			if (state == GLUT_WINDOW_BUFFER_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_BUFFER_SIZE);
-			if (state == GLUT_WINDOW_STENCIL_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_STENCIL_SIZE);
-			if (state == GLUT_WINDOW_DEPTH_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_DEPTH_SIZE);
-			if (state == GLUT_WINDOW_RED_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_RED_SIZE);
-			if (state == GLUT_WINDOW_GREEN_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_GREEN_SIZE);
-			if (state == GLUT_WINDOW_BLUE_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_BLUE_SIZE);
-			if (state == GLUT_WINDOW_ALPHA_SIZE)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_ALPHA_SIZE);
-			if (state == GLUT_WINDOW_ACCUM_RED_SIZE)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_RED_SIZE);
-			if (state == GLUT_WINDOW_ACCUM_GREEN_SIZE)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window,
-							       GDK_GL_ACCUM_GREEN_SIZE);
-			if (state == GLUT_WINDOW_ACCUM_BLUE_SIZE)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window, GDK_GL_ACCUM_BLUE_SIZE);
-			if (state == GLUT_WINDOW_ACCUM_ALPHA_SIZE)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window,
-							       GDK_GL_ACCUM_ALPHA_SIZE);
-			if (state == GLUT_WINDOW_DOUBLEBUFFER)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window,
-							       GDK_GL_DOUBLEBUFFER) ? 1 : 0;
-			if (state == GLUT_WINDOW_RGBA)
-				res = __gtkglut_gl_config_attrib(glut_window, GDK_GL_RGBA) ? 1 : 0;
+			__gtkglut_fb_config_get(glut_window, state, &res);
+
 			if (state == GLUT_WINDOW_PARENT)
 				res =
 				    glut_window->parent_window < 0 ? 0 : glut_window->parent_window;
@@ -397,16 +563,13 @@ int glutGet(GLenum state)
 									       child_list) : 0;
 			if (state == GLUT_WINDOW_COLORMAP_SIZE)
 				res = 0;
-			if (state == GLUT_WINDOW_NUM_SAMPLES)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window, GDK_GL_SAMPLE_BUFFERS);
-			if (state == GLUT_WINDOW_STEREO)
-				res =
-				    __gtkglut_gl_config_attrib(glut_window, GDK_GL_STEREO) ? 1 : 0;
 			if (state == GLUT_WINDOW_CURSOR)
 				res = glut_window->current_cursor;
-			if (state == GLUT_WINDOW_FORMAT_ID)
-				res = __gtkglut_gl_config_make_format_id(glut_window);
+			if (state == GTKGLUT_MOTION_COMPRESSION)
+				res = glut_window->motion_compression ? 1 : 0;
+			if (state == GTKGLUT_FRAME_DISPLAY_TIME || state == GTKGLUT_FRAME_SWAP_INTERVAL
+			    || state == GTKGLUT_FRAME_GPU_TIME)
+				res = __gtkglut_frame_stats_get_avg(glut_window, state);
 		} else {
 			/*
 			 * Make test8 happy
@@ -435,6 +598,78 @@ int glutGet(GLenum state)
 	return res;
 }
 
+/*!
+ * \brief    Query an GtkGLUT 64-bit state.
+ * \ingroup  state
+ * \param    state    Enumerated parameter ID.
+ *
+ * Works like glutGet(), but result is 64-bit integer, so it
+ * is possible to query time with high resolution.  Parameters
+ * specific to this function are:
+ *
+ * - \a GTKGLUT_ELAPSED_TIME_NSEC \n
+ *      Monotonic time elapsed since glutInit() in nanoseconds.
+ *
+ * - \a GTKGLUT_ELAPSED_TIME_USEC \n
+ *      Monotonic time elapsed since glutInit() in microseconds.
+ *
+ * All other parameters are passed to glutGet().
+ *
+ * \see glutGet(), glutAddTimerUsec()
+ */
+GLUTint64 glutGet64(GLenum state)
+{
+	gint64 elapsed;
+
+	switch (state) {
+	case GTKGLUT_ELAPSED_TIME_NSEC:
+	case GTKGLUT_ELAPSED_TIME_USEC:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		elapsed = __gtkglut_get_time_nsec() - __gtkglut_context->elapsed_time_start;
+
+		return (state == GTKGLUT_ELAPSED_TIME_USEC) ? elapsed / 1000 : elapsed;
+		break;
+	}
+
+	return glutGet(state);
+}
+
+/*!
+ * \brief    Query more GtkGLUT states at once.
+ * \ingroup  state
+ * \param    states    Array of enumerated parameter IDs.
+ * \param    out       Array, where results are stored.
+ * \param    n         Number of items in \a states and \a out .
+ *
+ * Same as calling glutGet() for every item of \a states , but
+ * current window is looked up only once and framebuffer
+ * attributes (\a GLUT_WINDOW_*_SIZE, \a GLUT_WINDOW_DOUBLEBUFFER,
+ * \a GLUT_WINDOW_RGBA, \a GLUT_WINDOW_STEREO,
+ * \a GLUT_WINDOW_NUM_SAMPLES and \a GLUT_WINDOW_FORMAT_ID) are
+ * read directly from values remembered at window creation.
+ * So it's cheap way to read whole configuration of window.
+ *
+ * \see glutGet()
+ */
+void glutGetv(const GLenum * states, int *out, int n)
+{
+	__gtkglut_window_struct *glut_window;
+	int i;
+
+	__gtkglut_test_inicialization("glutGetv");
+
+	glut_window = __gtkglut_get_window_by_id(__gtkglut_context->current_window);
+
+	for (i = 0; i < n; i++) {
+		if (!glut_window || !__gtkglut_fb_config_get(glut_window, states[i], &out[i])) {
+			out[i] = glutGet(states[i]);
+		}
+	}
+}
+
 /*!
  * \brief    Query the Alt, Shift and Ctrl keys.
  * \ingroup  inputstate
@@ -126,10 +126,101 @@ void glutInitWindowPosition(int x, int y)
  * - \a GLUT_INIT_WINDOW_Y \n
  *   Set the initial vertical position of new windows.
  *
+ * - \a GLUT_RENDERING_CONTEXT \n
+ *   \a GLUT_CREATE_NEW_CONTEXT (default) gives every new window
+ *   its own OpenGL context.  With \a GLUT_USE_CURRENT_CONTEXT,
+ *   context of new window shares display lists, textures, buffer
+ *   objects and shaders with context of *current window*, so
+ *   they are created only once for whole group of windows.
+ *
  * - \a GLUT_WINDOW_CURSOR \n
  *   Attempt to set the current cursor of *current window*
  *   as by calling glutSetCursor().
  *
+ * - \a GTKGLUT_EVENT_DISPATCH \n
+ *   Enable (1, default) or disable (0) direct dispatching of input
+ *   events.  Keyboard, mouse, motion, crossing and visibility events
+ *   of GtkGLUT windows are then given to callbacks straight from GDK
+ *   event handler, without GTK+ signal emission.  With 0, all events
+ *   go through GTK+.
+ *   \note Events handled directly never reach gtk_main_do_event(), so
+ *   gtk_get_current_event() and gtk_get_current_event_time() don't
+ *   return them and key snoopers installed by gtk_key_snooper_install()
+ *   don't see them.  Disable dispatching, if application mixes GLUT
+ *   callbacks with such GTK+ code.
+ *
+ * - \a GTKGLUT_FRAME_RATE \n
+ *   Set frame rate (in Hz) of paced main loop. Posted redisplays
+ *   are executed once per frame and main loop sleeps between
+ *   frames. On Linux, main loop is woken up at frame deadline
+ *   by timerfd, elsewhere frame can be late less than
+ *   millisecond. Value 0 (default) disables pacing.
+ *
+ * - \a GTKGLUT_GEOMETRY_CACHE \n
+ *   Enable (1, default) or disable (0) cache of window geometry.
+ *   With cache, glutGet() returns window position and size
+ *   remembered from last configure and size allocation events
+ *   instead of asking window system.  Disable it, if you need
+ *   exact values right after glutPositionWindow() or
+ *   glutReshapeWindow().
+ *
+ * - \a GTKGLUT_FRAME_STATS \n
+ *   Enable (1) or disable (0, default) collecting of frame statistics.
+ *   For every window is then measured time spent in display callback,
+ *   interval between glutSwapBuffers() calls and, with GL_ARB_timer_query,
+ *   GPU time of commands issued from display callback.  Statistics are
+ *   read by glutGetFrameStats().
+ *
+ * - \a GTKGLUT_IDLE_POLICY \n
+ *   Set when idle callback (see glutIdleFunc()) is called.
+ *   \a GTKGLUT_IDLE_ALWAYS (default) calls it in every main loop
+ *   iteration, \a GTKGLUT_IDLE_ONCE_PER_FRAME at most once per frame
+ *   of paced main loop (60 Hz if main loop is not paced) and
+ *   \a GTKGLUT_IDLE_WHEN_VISIBLE only while at least one window
+ *   is visible and not iconified.
+ *
+ * - \a GTKGLUT_MAX_FRAMES_IN_FLIGHT \n
+ *   Limit how many frames CPU can run ahead of GPU (1 - 8).
+ *   glutSwapBuffers() then inserts GL_ARB_sync fence after every
+ *   frame and waits for fence of frame, which is this number of
+ *   frames old.  This keeps input latency bounded without stall
+ *   of glFinish().  Value 0 (default) disables limit.
+ *
+ * - \a GTKGLUT_MESH_CACHE_SIZE \n
+ *   Memory limit of mesh cache in kilobytes (default 16384).  Spheres,
+ *   cones, tori and cylinders are generated once per OpenGL context
+ *   into vertex buffer objects (or client arrays without
+ *   GL_ARB_vertex_buffer_object) and then drawn scaled by glScale.
+ *   Least recently used meshes are evicted, when limit is reached.
+ *   Shape, whose mesh doesn't fit under limit (meshes of other
+ *   windows are not evicted), is drawn in immediate mode.
+ *   Value 0 disables cache, so shapes are drawn in immediate mode.
+ *   Meshes already cached are released with their window.
+ *
+ * - \a GTKGLUT_MOTION_COMPRESSION \n
+ *   Enable (1) or disable (0, default) motion compression on
+ *   *current window*.  Motion events are then collapsed and motion
+ *   callbacks are called only with last position once per main loop
+ *   iteration.  All samples are still reported to motion history
+ *   callback (see glutMotionHistoryFunc()).
+ *
+ * - \a GTKGLUT_POINTER_CACHE \n
+ *   Enable (1, default) or disable (0) cache of pointer position.
+ *   With cache, keyboard callbacks get mouse position remembered
+ *   from last motion, crossing or button event instead of asking
+ *   window system on every key press and release.
+ *
+ * - \a GTKGLUT_SKIP_HIDDEN_REDISPLAY \n
+ *   Enable (1) or disable (0, default) skipping of display callback
+ *   for windows, which are hidden, iconified or fully covered.
+ *   Such window is redisplayed once, when it becomes visible.
+ *
+ * - \a GTKGLUT_TEAPOT_GRID \n
+ *   Number of divisions of every Bezier patch of teapot in both
+ *   directions (1 - 64, default 10).  With enabled mesh cache, teapot
+ *   is tessellated on CPU with this resolution and drawn from cache
+ *   instead of OpenGL evaluators.
+ *
  * \see glutGet(), glutDeviceGet(), glutGetModifiers(),
  *      glutLayerGet(), glutDestroyWindow(), glutMainLoop(),
  *      glutInitDisplayMode(), glutInit(), glutInitWindowSize(),
@@ -175,6 +266,118 @@ void glutSetOption(int what, int value)
 
 		__gtkglut_context->action_on_window_close = value;
 		break;
+
+	case GLUT_RENDERING_CONTEXT:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_context->rendering_context = value;
+		break;
+
+	case GTKGLUT_EVENT_DISPATCH:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_set_event_dispatch(value);
+		break;
+
+	case GTKGLUT_FRAME_RATE:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_set_frame_rate(value);
+		break;
+
+	case GTKGLUT_GEOMETRY_CACHE:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_context->geometry_cache = (value != 0);
+		break;
+
+	case GTKGLUT_IDLE_POLICY:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_set_idle_policy(value);
+		break;
+
+	case GTKGLUT_FRAME_STATS:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		if (value && !__gtkglut_context->frame_stats)
+			__gtkglut_context->frame_stats_epoch++;
+
+		__gtkglut_context->frame_stats = value ? TRUE : FALSE;
+		break;
+
+	case GTKGLUT_MAX_FRAMES_IN_FLIGHT:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		if (value < 0 || value > __GTKGLUT_MAX_FRAMES_IN_FLIGHT) {
+			__gtkglut_warning("glutSetOption", "frames in flight must be 0 - %d",
+					  __GTKGLUT_MAX_FRAMES_IN_FLIGHT);
+			break;
+		}
+
+		__gtkglut_context->max_frames_in_flight = value;
+		break;
+
+	case GTKGLUT_MESH_CACHE_SIZE:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		if (value < 0) {
+			__gtkglut_warning("glutSetOption", "mesh cache size can't be negative");
+			break;
+		}
+
+		__gtkglut_context->mesh_cache_limit = (gsize) value * 1024;
+		break;
+
+	case GTKGLUT_TEAPOT_GRID:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		if (value < 1 || value > __GTKGLUT_TEAPOT_MAX_GRID) {
+			__gtkglut_warning("glutSetOption", "teapot grid must be 1 - %d",
+					  __GTKGLUT_TEAPOT_MAX_GRID);
+			break;
+		}
+
+		__gtkglut_context->teapot_grid = value;
+		break;
+
+	case GTKGLUT_MOTION_COMPRESSION:
+		__gtkglut_set_motion_compression(value);
+		break;
+
+	case GTKGLUT_POINTER_CACHE:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_set_pointer_cache(value);
+		break;
+
+	case GTKGLUT_SKIP_HIDDEN_REDISPLAY:
+		if (!__gtkglut_context) {
+			__gtkglut_context_init();
+		}
+
+		__gtkglut_set_skip_hidden_redisplay(value);
+		break;
 	}
 }
 
@@ -843,6 +1046,11 @@ void glutInit(int *argcp, char **argv)
 	 */
 	gtk_gl_init(argcp, &argv);
 
+	/*
+	 * Input events of our windows bypass GTK+ signal emission
+	 */
+	gdk_event_handler_set(__gtkglut_event_dispatch, NULL, NULL);
+
 	__gtkglut_context->is_inicialized = 1;
 
 	__gtkglut_parse_params_geometry(geometry);
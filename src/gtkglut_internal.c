@@ -156,12 +156,58 @@ void __gtkglut_context_init(void)
 	glutInitWindowPosition(__GTKGLUT_WINDOW_INIT_X, __GTKGLUT_WINDOW_INIT_Y);
 	glutInitDisplayMode(__GTKGLUT_INIT_DISPLAY_MODE);
 	__gtkglut_context->elapsed_time_timer = g_timer_new();
+	__gtkglut_context->elapsed_time_start = __gtkglut_get_time_nsec();
 	__gtkglut_context->callback_idle = NULL;
+	__gtkglut_context->idle_source = NULL;
+	__gtkglut_context->idle_policy = GTKGLUT_IDLE_ALWAYS;
+	__gtkglut_context->idle_deadline = 0;
+	__gtkglut_context->skip_hidden_redisplay = FALSE;
+	__gtkglut_context->geometry_cache = TRUE;
+	__gtkglut_context->pointer_cache = TRUE;
+	__gtkglut_keysym_table_init();
+	__gtkglut_context->event_dispatch = TRUE;
+	__gtkglut_context->max_frames_in_flight = 0;
+	__gtkglut_context->fence_sync_supported = __GTKGLUT_UNDEFINED;
+	__gtkglut_context->gl_fence_sync = NULL;
+	__gtkglut_context->gl_client_wait_sync = NULL;
+	__gtkglut_context->gl_delete_sync = NULL;
+	__gtkglut_context->frame_stats = FALSE;
+	__gtkglut_context->frame_stats_epoch = 0;
+	__gtkglut_context->timer_query_supported = __GTKGLUT_UNDEFINED;
+	__gtkglut_context->gl_gen_queries = NULL;
+	__gtkglut_context->gl_delete_queries = NULL;
+	__gtkglut_context->gl_begin_query = NULL;
+	__gtkglut_context->gl_end_query = NULL;
+	__gtkglut_context->gl_get_query_objectiv = NULL;
+	__gtkglut_context->gl_get_query_objectui64v = NULL;
+	__gtkglut_context->mesh_cache = NULL;
+	__gtkglut_context->mesh_lru_first = NULL;
+	__gtkglut_context->mesh_lru_last = NULL;
+	__gtkglut_context->mesh_cache_used = 0;
+	__gtkglut_context->mesh_cache_limit = __GTKGLUT_MESH_CACHE_SIZE * 1024;
+	__gtkglut_context->teapot_grid = __GTKGLUT_TEAPOT_GRID;
+	__gtkglut_context->buffer_objects_supported = __GTKGLUT_UNDEFINED;
+	__gtkglut_context->gl_gen_buffers = NULL;
+	__gtkglut_context->gl_bind_buffer = NULL;
+	__gtkglut_context->gl_buffer_data = NULL;
+	__gtkglut_context->gl_delete_buffers = NULL;
+	__gtkglut_context->instancing_supported = __GTKGLUT_UNDEFINED;
+	memset(&__gtkglut_context->instancing_funcs, 0, sizeof(__gtkglut_instancing_funcs_struct));
+	__gtkglut_context->instanced_programs = NULL;
+	__gtkglut_context->circle_tables = NULL;
+	__gtkglut_context->window_id_quark = g_quark_from_static_string("gtkglut-window-id");
+	__gtkglut_context->thread_queue = NULL;
+	__gtkglut_context->thread_source = __gtkglut_thread_source_new();
 	__gtkglut_context->actual_gl_config = NULL;
 	__gtkglut_context->window_array = NULL;
+	__gtkglut_context->window_ids = NULL;
+	__gtkglut_context->window_free_slots = NULL;
 	__gtkglut_context->menu_array = NULL;
+	__gtkglut_context->menu_ids = NULL;
+	__gtkglut_context->menu_free_slots = NULL;
 	__gtkglut_context->current_gl_drawable = NULL;
 	__gtkglut_context->current_gl_context = NULL;
+	__gtkglut_context->gl_context_switches = 0;
 	__gtkglut_context->current_window = -1;
 	__gtkglut_context->current_menu = -1;
 	__gtkglut_init_cursors_cache();
@@ -170,8 +216,21 @@ void __gtkglut_context_init(void)
 	__gtkglut_context->menu_status_func = NULL;
 	__gtkglut_context->menu_state_func = NULL;
 	__gtkglut_context->action_on_window_close = GLUT_ACTION_EXIT;
+	__gtkglut_context->rendering_context = GLUT_CREATE_NEW_CONTEXT;
 	__gtkglut_context->no_active_toplevel_windows = 0;
 	__gtkglut_context->current_active_menu_window_id = -1;
+	__gtkglut_context->dirty_windows = g_ptr_array_new();
+	__gtkglut_context->dirty_windows_flush = g_ptr_array_new();
+	__gtkglut_context->redisplay_source = __gtkglut_redisplay_source_new();
+	__gtkglut_context->motion_windows = g_ptr_array_new();
+	__gtkglut_context->motion_windows_flush = g_ptr_array_new();
+	__gtkglut_context->motion_source = NULL;
+	__gtkglut_context->timer_wheel = NULL;
+	__gtkglut_context->frame_rate = 0;
+	__gtkglut_context->frame_period = 0;
+	__gtkglut_context->frame_deadline = 0;
+	__gtkglut_context->frame_timer = 0;
+	__gtkglut_context->frame_timer_deadline = 0;
 }
 
 /*
@@ -236,3 +295,81 @@ void __gtkglut_unimplemented_warning(char *func_name)
 {
 	__gtkglut_warning(func_name, "function is not implemented");
 }
+
+/*
+ * Store item to id table. Free slot is reused with next generation of id, otherwise
+ * new slot is appended. Slot 0 is never used, because GLUT numbers from 1.
+ */
+int __gtkglut_id_table_add(GPtrArray ** items, GArray ** ids, GArray ** free_slots,
+			   gpointer item)
+{
+	guint slot;
+	int id;
+
+	if (!*items) {
+		*items = g_ptr_array_new();
+		*ids = g_array_new(FALSE, FALSE, sizeof(int));
+		*free_slots = g_array_new(FALSE, FALSE, sizeof(guint));
+
+		if (!*items || !*ids || !*free_slots)
+			__gtkglut_lowmem();
+
+		id = 0;
+		g_ptr_array_add(*items, NULL);
+		g_array_append_val(*ids, id);
+	}
+
+	if ((*free_slots)->len > 0) {
+		slot = g_array_index(*free_slots, guint, (*free_slots)->len - 1);
+		g_array_set_size(*free_slots, (*free_slots)->len - 1);
+
+		id = __GTKGLUT_ID_NEXT_GENERATION(g_array_index(*ids, int, slot));
+
+		g_ptr_array_index(*items, slot) = item;
+		g_array_index(*ids, int, slot) = id;
+	} else {
+		slot = (*items)->len;
+
+		if (slot > __GTKGLUT_ID_SLOT_MASK)
+			return 0;
+
+		id = slot;
+
+		g_ptr_array_add(*items, item);
+		g_array_append_val(*ids, id);
+	}
+
+	return id;
+}
+
+/*
+ * Get item of id table. Id must match id of slot, so stale id of reused slot
+ * returns NULL.
+ */
+gpointer __gtkglut_id_table_get(GPtrArray * items, GArray * ids, int id)
+{
+	guint slot;
+
+	if (id <= 0 || !items)
+		return NULL;
+
+	slot = __GTKGLUT_ID_SLOT(id);
+
+	if (slot >= items->len || g_array_index(ids, int, slot) != id)
+		return NULL;
+
+	return g_ptr_array_index(items, slot);
+}
+
+/*
+ * Remove item with valid id from id table
+ */
+void __gtkglut_id_table_remove(GPtrArray * items, GArray * free_slots, int id)
+{
+	guint slot;
+
+	slot = __GTKGLUT_ID_SLOT(id);
+
+	g_ptr_array_index(items, slot) = NULL;
+	g_array_append_val(free_slots, slot);
+}
@@ -12,6 +12,13 @@ extern "C" {
 #include <gdk/gdkkeysyms.h>
 #include <gdk/gdk.h>
 
+/*
+ * Calling convention of GL functions got by glutGetProcAddress() (stdcall on Windows)
+ */
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
 #define  __GTKGLUT_MAJOR_VERSION 0
 #define  __GTKGLUT_MINOR_VERSION 3
 #define  __GTKGLUT_MICRO_VERSION 7
@@ -34,6 +41,54 @@ extern "C" {
 
 #define __GTKGLUT_MAX_MENU_DEPTH 64
 
+/*
+ * Maximal value of GTKGLUT_MAX_FRAMES_IN_FLIGHT
+ */
+#define __GTKGLUT_MAX_FRAMES_IN_FLIGHT 8
+
+/*
+ * Number of frames in rolling frame statistics and number of GPU timer
+ * queries, which can be pending per window
+ */
+#define __GTKGLUT_FRAME_STATS_SAMPLES 128
+#define __GTKGLUT_FRAME_STATS_QUERIES 4
+
+/*
+ * Default limit of mesh cache in kilobytes and maximal number of vertices
+ * of cached mesh (bigger shapes are drawn in immediate mode)
+ */
+#define __GTKGLUT_MESH_CACHE_SIZE (16 * 1024)
+#define __GTKGLUT_MESH_MAX_VERTICES (1024 * 1024)
+
+/*
+ * Shapes in mesh cache
+ */
+#define __GTKGLUT_MESH_SPHERE   1
+#define __GTKGLUT_MESH_CONE     2
+#define __GTKGLUT_MESH_TORUS    3
+#define __GTKGLUT_MESH_CYLINDER 4
+#define __GTKGLUT_MESH_CUBE     5
+#define __GTKGLUT_MESH_SPONGE   6
+#define __GTKGLUT_MESH_TEAPOT   7
+
+/*
+ * Default and maximal grid resolution of one Bezier patch of tessellated teapot
+ */
+#define __GTKGLUT_TEAPOT_GRID     10
+#define __GTKGLUT_TEAPOT_MAX_GRID 64
+
+/*
+ * Window and menu id is slot in array (low 16 bits) with generation of slot
+ * (bits 16 - 30). Generation is incremented, when slot is reused, so id
+ * of destroyed window or menu stays invalid.
+ */
+#define __GTKGLUT_ID_SLOT_BITS 16
+#define __GTKGLUT_ID_SLOT_MASK ((1 << __GTKGLUT_ID_SLOT_BITS) - 1)
+#define __GTKGLUT_ID_SLOT(id) ((id) & __GTKGLUT_ID_SLOT_MASK)
+#define __GTKGLUT_ID_NEXT_GENERATION(id) \
+	(__GTKGLUT_ID_SLOT(id) | ((((id) >> __GTKGLUT_ID_SLOT_BITS) + 1) & 0x7FFF) << \
+	 __GTKGLUT_ID_SLOT_BITS)
+
 typedef struct __gtkglut_geometry_struct {
 	int x, y, width, height;
 } __gtkglut_geometry_struct;
@@ -48,6 +103,185 @@ typedef struct __gtkglut_refset_item {
 	int value;
 } __gtkglut_refset_item;
 
+#define __GTKGLUT_TIMER_WHEEL_LEVELS  4
+#define __GTKGLUT_TIMER_WHEEL_BITS    8
+#define __GTKGLUT_TIMER_WHEEL_SIZE    (1 << __GTKGLUT_TIMER_WHEEL_BITS)
+#define __GTKGLUT_TIMER_SLAB_SIZE     256
+#define __GTKGLUT_TIMER_INDEX_BITS    20
+
+/*
+ * Level of precise (microsecond) timer, which is kept in heap instead of wheel
+ */
+#define __GTKGLUT_TIMER_PRECISE       -1
+
+typedef struct __gtkglut_timer_struct {
+	struct __gtkglut_timer_struct *next;
+	struct __gtkglut_timer_struct *prev;
+	/*
+	 * Expiration and period in wheel ticks (milliseconds) or in microseconds
+	 * for precise timer
+	 */
+	gint64 expires;
+	gint64 period;
+	int level;
+	/*
+	 * Position in heap of precise timers
+	 */
+	int heap_index;
+	int state;
+	/*
+	 * Generation and index of timer node
+	 */
+	int handle;
+	void (*func) (int value);
+	int value;
+} __gtkglut_timer_struct;
+
+typedef struct __gtkglut_timer_wheel_struct {
+	/*
+	 * Heads of slot lists
+	 */
+	__gtkglut_timer_struct slots[__GTKGLUT_TIMER_WHEEL_LEVELS][__GTKGLUT_TIMER_WHEEL_SIZE];
+	int level_count[__GTKGLUT_TIMER_WHEEL_LEVELS];
+	gint64 base_time;
+	/*
+	 * Current tick of wheel
+	 */
+	gint64 time;
+	/*
+	 * Number of timers in wheel (precise timers are not counted)
+	 */
+	int no_timers;
+	GPtrArray *slabs;
+	__gtkglut_timer_struct *free_list;
+	/*
+	 * Binary min-heap of precise timers
+	 */
+	GPtrArray *precise_heap;
+	/*
+	 * Timerfd used for waking up precise timers (fd is -1 if not available)
+	 * and its armed expiration (-1 if disarmed)
+	 */
+	GPollFD precise_fd;
+	gint64 precise_fd_expires;
+	GSource *source;
+} __gtkglut_timer_wheel_struct;
+
+/*
+ * Request posted from other thread. If func is NULL, it's redisplay of window.
+ */
+typedef struct __gtkglut_thread_task_struct {
+	struct __gtkglut_thread_task_struct *next;
+	void (*func) (void *data);
+	void *data;
+	int window_id;
+} __gtkglut_thread_task_struct;
+
+/*
+ * Mesh built by shape generator. Every vertex is normal followed by position
+ * (6 floats, GL_N3F_V3F layout). num_vertices and num_indices are number of
+ * stored items, arrays may be bigger.
+ */
+typedef struct __gtkglut_mesh_data_struct {
+	GLfloat *vertices;
+	int num_vertices;
+	GLuint *indices;
+	int num_indices;
+	GLenum mode;
+	/*
+	 * If set, generator only stores capacity of mesh to num_vertices and
+	 * num_indices and returns without generating
+	 */
+	gboolean measure;
+} __gtkglut_mesh_data_struct;
+
+/*
+ * Generator of unit sized shape (size is applied by glScale)
+ */
+typedef void (*__gtkglut_mesh_generator) (__gtkglut_mesh_data_struct * data, GLfloat param,
+    int slices, int stacks, gboolean solid);
+
+typedef struct __gtkglut_mesh_key_struct {
+	GdkGLContext *gl_context;
+	int shape;
+	GLfloat param;
+	int slices;
+	int stacks;
+	gboolean solid;
+} __gtkglut_mesh_key_struct;
+
+/*
+ * Cached mesh. With buffer objects, data are only in buffers (vertices and
+ * indices are NULL), otherwise they are drawn from client arrays.
+ * Meshes form LRU list with most recently used mesh first.
+ */
+typedef struct __gtkglut_mesh_struct {
+	__gtkglut_mesh_key_struct key;
+	struct __gtkglut_mesh_struct *prev;
+	struct __gtkglut_mesh_struct *next;
+	GLuint buffers[2];
+	GLfloat *vertices;
+	GLuint *indices;
+	int num_indices;
+	GLenum mode;
+	gsize size;
+} __gtkglut_mesh_struct;
+
+/*
+ * GL 2.0 and instancing functions used by instanced drawing of shapes
+ */
+typedef struct __gtkglut_instancing_funcs_struct {
+	GLuint(APIENTRY * create_shader) (GLenum type);
+	void (APIENTRY * shader_source) (GLuint shader, GLsizei count, const char **string,
+	    const GLint * length);
+	void (APIENTRY * compile_shader) (GLuint shader);
+	void (APIENTRY * get_shaderiv) (GLuint shader, GLenum pname, GLint * params);
+	void (APIENTRY * delete_shader) (GLuint shader);
+	GLuint(APIENTRY * create_program) (void);
+	void (APIENTRY * attach_shader) (GLuint program, GLuint shader);
+	void (APIENTRY * bind_attrib_location) (GLuint program, GLuint index, const char *name);
+	void (APIENTRY * link_program) (GLuint program);
+	void (APIENTRY * get_programiv) (GLuint program, GLenum pname, GLint * params);
+	void (APIENTRY * delete_program) (GLuint program);
+	void (APIENTRY * use_program) (GLuint program);
+	GLint(APIENTRY * get_uniform_location) (GLuint program, const char *name);
+	void (APIENTRY * uniform1i) (GLint location, GLint v0);
+	void (APIENTRY * uniform1iv) (GLint location, GLsizei count, const GLint * value);
+	void (APIENTRY * uniform3f) (GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+	void (APIENTRY * vertex_attrib_pointer) (GLuint index, GLint size, GLenum type,
+	    GLboolean normalized, GLsizei stride, const GLvoid * pointer);
+	void (APIENTRY * enable_vertex_attrib_array) (GLuint index);
+	void (APIENTRY * disable_vertex_attrib_array) (GLuint index);
+	void (APIENTRY * vertex_attrib_divisor) (GLuint index, GLuint divisor);
+	void (APIENTRY * draw_elements_instanced) (GLenum mode, GLsizei count, GLenum type,
+	    const GLvoid * indices, GLsizei primcount);
+} __gtkglut_instancing_funcs_struct;
+
+/*
+ * Shader program for instanced drawing (one per GL context) and locations
+ * of its uniforms
+ */
+typedef struct __gtkglut_instanced_program_struct {
+	GLuint program;
+	GLint scale;
+	GLint instance_colors;
+	GLint lighting;
+	GLint color_material;
+	GLint lights;
+} __gtkglut_instanced_program_struct;
+
+/*
+ * Table of sin and cos values of circle (see __gtkglut_circle_table).
+ * Arrays point to 16 bytes aligned part of memory. Table which is not cached
+ * is freed by __gtkglut_circle_table_free.
+ */
+typedef struct __gtkglut_circle_table_struct {
+	GLfloat *sint;
+	GLfloat *cost;
+	gpointer memory;
+	gboolean cached;
+} __gtkglut_circle_table_struct;
+
 typedef struct __gtkglut_context_struct {
 	int is_inicialized;
 	__gtkglut_geometry_struct window_init_geometry;
@@ -56,12 +290,109 @@ typedef struct __gtkglut_context_struct {
 	int direct_render;
 	unsigned int display_mode;
 	GTimer *elapsed_time_timer;
+	/*
+	 * Monotonic time of inicialization in nanoseconds
+	 */
+	gint64 elapsed_time_start;
 	void (*callback_idle) (void);
+	/*
+	 * Idle source, its policy and (for GTKGLUT_IDLE_ONCE_PER_FRAME) deadline of
+	 * next call in microseconds
+	 */
+	GSource *idle_source;
+	int idle_policy;
+	gint64 idle_deadline;
+	/*
+	 * Don't call display callback of hidden windows
+	 */
+	gboolean skip_hidden_redisplay;
+	/*
+	 * glutGet returns window geometry from cache
+	 */
+	gboolean geometry_cache;
+	/*
+	 * Keyboard callbacks get pointer position from cache
+	 */
+	gboolean pointer_cache;
+	/*
+	 * Input events are dispatched directly from GDK event handler. Quark of
+	 * window id data of drawing area.
+	 */
+	gboolean event_dispatch;
+	GQuark window_id_quark;
+	/*
+	 * Number of frames CPU can run ahead of GPU (0 = unlimited) and
+	 * ARB_sync functions (fence_sync_supported is __GTKGLUT_UNDEFINED,
+	 * until first fence is needed)
+	 */
+	int max_frames_in_flight;
+	int fence_sync_supported;
+	gpointer(APIENTRY * gl_fence_sync) (GLenum condition, GLbitfield flags);
+	GLenum(APIENTRY * gl_client_wait_sync) (gpointer sync, GLbitfield flags, guint64 timeout);
+	void (APIENTRY * gl_delete_sync) (gpointer sync);
+	/*
+	 * Frame statistics are collected, epoch is incremented, when collecting
+	 * is enabled. ARB_timer_query functions (timer_query_supported is
+	 * __GTKGLUT_UNDEFINED, until first query is needed).
+	 */
+	gboolean frame_stats;
+	int frame_stats_epoch;
+	int timer_query_supported;
+	void (APIENTRY * gl_gen_queries) (GLsizei n, GLuint * ids);
+	void (APIENTRY * gl_delete_queries) (GLsizei n, const GLuint * ids);
+	void (APIENTRY * gl_begin_query) (GLenum target, GLuint id);
+	void (APIENTRY * gl_end_query) (GLenum target);
+	void (APIENTRY * gl_get_query_objectiv) (GLuint id, GLenum pname, GLint * params);
+	void (APIENTRY * gl_get_query_objectui64v) (GLuint id, GLenum pname, guint64 * params);
+	/*
+	 * Mesh cache of built-in shapes. Sizes are in bytes, limit 0 disables
+	 * cache. Buffer object functions (buffer_objects_supported is
+	 * __GTKGLUT_UNDEFINED, until first mesh is built).
+	 */
+	GHashTable *mesh_cache;
+	__gtkglut_mesh_struct *mesh_lru_first;
+	__gtkglut_mesh_struct *mesh_lru_last;
+	gsize mesh_cache_used;
+	gsize mesh_cache_limit;
+	int teapot_grid;
+	int buffer_objects_supported;
+	void (APIENTRY * gl_gen_buffers) (GLsizei n, GLuint * buffers);
+	void (APIENTRY * gl_bind_buffer) (GLenum target, GLuint buffer);
+	void (APIENTRY * gl_buffer_data) (GLenum target, gssize size, const GLvoid * data,
+	    GLenum usage);
+	void (APIENTRY * gl_delete_buffers) (GLsizei n, const GLuint * buffers);
+	/*
+	 * Instanced drawing (instancing_supported is __GTKGLUT_UNDEFINED, until
+	 * first instanced draw). Programs are hashed by GL context.
+	 */
+	int instancing_supported;
+	__gtkglut_instancing_funcs_struct instancing_funcs;
+	GHashTable *instanced_programs;
+	/*
+	 * Circle tables of round shapes hashed by number of samples
+	 */
+	GHashTable *circle_tables;
+	/*
+	 * Lock-free stack of requests posted from other threads, its wakeup fd
+	 * (-1 if not available) and source
+	 */
+	volatile gpointer thread_queue;
+	GPollFD thread_fd;
+	GSource *thread_source;
 	GdkGLConfig *actual_gl_config;
+	/*
+	 * Windows and menus indexed by slot, current (or last, for free slot) id
+	 * of every slot and stack of free slots
+	 */
 	GPtrArray *window_array;
+	GArray *window_ids;
+	GArray *window_free_slots;
 	GPtrArray *menu_array;
+	GArray *menu_ids;
+	GArray *menu_free_slots;
 	GdkGLDrawable *current_gl_drawable;
 	GdkGLContext *current_gl_context;
+	int gl_context_switches;
 	int current_window;
 	int current_menu;
 	__gtkglut_cursors_cache_struct *cursors_cache;
@@ -70,14 +401,40 @@ typedef struct __gtkglut_context_struct {
 	void (*menu_status_func) (int status, int x, int y);
 	void (*menu_state_func) (int status);
 	int action_on_window_close;
+	/*
+	 * GLUT_CREATE_NEW_CONTEXT or GLUT_USE_CURRENT_CONTEXT (new windows share
+	 * display lists, textures and buffers with current window)
+	 */
+	int rendering_context;
 	int no_active_toplevel_windows;
 	int current_active_menu_window_id;
+	/*
+	 * Ids of windows with pending redisplay. Second array is used while
+	 * redisplays are executed.
+	 */
+	GPtrArray *dirty_windows;
+	GPtrArray *dirty_windows_flush;
+	GSource *redisplay_source;
+	/*
+	 * Ids of windows with compressed motion not yet delivered
+	 */
+	GPtrArray *motion_windows;
+	GPtrArray *motion_windows_flush;
+	GSource *motion_source;
+	__gtkglut_timer_wheel_struct *timer_wheel;
+	/*
+	 * Frame pacing. frame_period is in microseconds, 0 if pacing is disabled
+	 */
+	int frame_rate;
+	gint64 frame_period;
+	gint64 frame_deadline;
+	/*
+	 * Precise timer waking up main loop at frame_timer_deadline (0 if not armed)
+	 */
+	int frame_timer;
+	gint64 frame_timer_deadline;
 } __gtkglut_context_struct;
 
-typedef struct __gtkglut_timer_callback_struct {
-	int value;
-	void (*func) (int value);
-} __gtkglut_timer_callback_struct;
 
 typedef struct __gtkglut_signal_struct {
 	/*
@@ -88,16 +445,72 @@ typedef struct __gtkglut_signal_struct {
 	 * Function called from gtk_event_handler
 	 */
 	gpointer glut_callback_handler;
-	/*
-	 * Signal id, for deregistering
-	 */
-	int signal_id;
 	/*
 	 * if event is added
 	 */
 	gboolean event_added;
 } __gtkglut_signal_struct;
 
+/*
+ * Event handler called by event dispatcher, same as GTK+ event signal handler
+ */
+typedef gboolean(*__gtkglut_event_func) (GtkWidget * widget, GdkEvent * event, gpointer data);
+
+/*
+ * Event dispatcher handles event types up to GDK_SCROLL
+ */
+#define __GTKGLUT_EVENT_TABLE_SIZE	(GDK_SCROLL + 1)
+
+/*
+ * Framebuffer attributes of window, read once when window is created
+ */
+typedef struct __gtkglut_fb_config_struct {
+	short buffer_size;
+	short stencil_size;
+	short depth_size;
+	short red_size;
+	short green_size;
+	short blue_size;
+	short alpha_size;
+	short accum_red_size;
+	short accum_green_size;
+	short accum_blue_size;
+	short accum_alpha_size;
+	short num_samples;
+	unsigned char doublebuffer;
+	unsigned char rgba;
+	unsigned char stereo;
+	int format_id;
+} __gtkglut_fb_config_struct;
+
+/*
+ * Ring of last frame times in microseconds. count is number of samples
+ * stored so far, next sample goes to count modulo size.
+ */
+typedef struct __gtkglut_frame_time_struct {
+	int samples[__GTKGLUT_FRAME_STATS_SAMPLES];
+	int count;
+} __gtkglut_frame_time_struct;
+
+/*
+ * Rolling frame statistics of window. GPU timer queries form ring, where
+ * query_first is oldest pending query.
+ */
+typedef struct __gtkglut_frame_stats_struct {
+	int frames;
+	int epoch;
+	gint64 display_start;
+	gint64 last_swap;
+	__gtkglut_frame_time_struct display_time;
+	__gtkglut_frame_time_struct swap_interval;
+	__gtkglut_frame_time_struct gpu_time;
+	GLuint queries[__GTKGLUT_FRAME_STATS_QUERIES];
+	gboolean queries_generated;
+	int query_first;
+	int query_pending;
+	gboolean query_active;
+} __gtkglut_frame_stats_struct;
+
 typedef struct __gtkglut_window_struct {
 	GtkWidget *window;
 	GtkWidget *drawing_area;
@@ -112,6 +525,37 @@ typedef struct __gtkglut_window_struct {
 	int current_cursor;
 	gboolean damaged;
 	gboolean iconified;
+	gboolean redisplay_pending;
+	/*
+	 * Redisplay was skipped, because window was hidden
+	 */
+	gboolean redisplay_deferred;
+	/*
+	 * Cached geometry. Size is updated on size allocation, position (root
+	 * origin of toplevel) on configure event of toplevel.
+	 */
+	__gtkglut_geometry_struct geometry;
+	gboolean geometry_size_valid;
+	gboolean geometry_position_valid;
+	/*
+	 * Last pointer position seen in motion, crossing or button event.
+	 * Valid only while pointer is inside window.
+	 */
+	int pointer_x;
+	int pointer_y;
+	gboolean pointer_valid;
+	__gtkglut_fb_config_struct fb_config;
+	/*
+	 * Ring of fences of last frames (GLsync), number of fences used when they
+	 * were inserted and position of next fence
+	 */
+	gpointer frame_fences[__GTKGLUT_MAX_FRAMES_IN_FLIGHT];
+	int frames_in_flight;
+	int frame_fence_index;
+	/*
+	 * Frame statistics, NULL until first frame with statistics enabled
+	 */
+	__gtkglut_frame_stats_struct *frame_stats;
 	void (*callback_display) (void);
 	void (*callback_reshape) (int width, int height);
 	__gtkglut_signal_struct signal_visibility;
@@ -126,6 +570,23 @@ typedef struct __gtkglut_window_struct {
 	__gtkglut_signal_struct signal_motion;
 	__gtkglut_signal_struct signal_passive_motion;
 	__gtkglut_signal_struct signal_entry;
+	__gtkglut_signal_struct signal_motion_history;
+	/*
+	 * Handlers of input events indexed by event type, used by event dispatcher.
+	 * NULL entry means, event is passed to GTK+.
+	 */
+	__gtkglut_event_func event_table[__GTKGLUT_EVENT_TABLE_SIZE];
+	/*
+	 * Ids of GTK+ signals connected for event table, when event dispatcher is disabled
+	 */
+	gulong event_signal[__GTKGLUT_EVENT_TABLE_SIZE];
+	/*
+	 * Motion compression. Samples of motion events not yet delivered and
+	 * state of last event.
+	 */
+	gboolean motion_compression;
+	GArray *motion_history;
+	guint motion_state;
 	void (*callback_close) (void);
 	int mouse_button_menu[__GTKGLUT_MAX_MOUSE_BUTTONS];
 	void *user_data;
@@ -264,6 +725,27 @@ extern GdkGLConfig *__gtkglut_init_gl_config(void);
  */
 extern void __gtkglut_gl_debug();
 
+/*
+ * Store item to free slot of id table. Returns new id, or 0 if table is full.
+ */
+extern int __gtkglut_id_table_add(GPtrArray ** items, GArray ** ids, GArray ** free_slots,
+    gpointer item);
+
+/*
+ * Get item of id table by id. Returns NULL for invalid or stale id.
+ */
+extern gpointer __gtkglut_id_table_get(GPtrArray * items, GArray * ids, int id);
+
+/*
+ * Free slot of item with id
+ */
+extern void __gtkglut_id_table_remove(GPtrArray * items, GArray * free_slots, int id);
+
+/*
+ * Id of item in slot of id table
+ */
+#define __gtkglut_id_table_slot_id(ids, slot) g_array_index(ids, int, slot)
+
 /*
  * Get glut window indetified by window_id
  */
@@ -285,13 +767,6 @@ extern void __gtkglut_unimplemented_warning(char *func_name);
  */
 extern __gtkglut_menu_struct *__gtkglut_get_menu_by_id(int menu_id);
 
-/*
- * For use in gtkglut_menu
- */
-extern void __gtkglut_register_mouse_func(__gtkglut_window_struct * glut_window);
-extern void __gtkglut_unregister_mouse_func(__gtkglut_window_struct * glut_window,
-    int menu_button);
-
 /*
  * Call menu status/state function from window with id window_id and menu with id menu_id
  */
@@ -309,6 +784,158 @@ extern void __gtkglut_set_menu_in_use(__gtkglut_menu_struct * glut_menu, gboolea
  */
 extern __gtkglut_menu_struct *__gtkglut_get_active_menu_with_warning(char *func_name);
 
+/*
+ * Create source executing pending redisplays once per main loop iteration
+ */
+extern GSource *__gtkglut_redisplay_source_new(void);
+
+/*
+ * Set frame rate of paced main loop. Value <= 0 disables pacing
+ */
+extern void __gtkglut_set_frame_rate(int frame_rate);
+
+/*
+ * Add window to set of windows with pending redisplay
+ */
+extern void __gtkglut_queue_window_redisplay(__gtkglut_window_struct * glut_window,
+    int window_id);
+
+/*
+ * Execute pending redisplay of window (call display callback)
+ */
+extern void __gtkglut_display_window(int window_id);
+
+/*
+ * Enable or disable motion compression on current window
+ */
+extern void __gtkglut_set_motion_compression(int value);
+
+/*
+ * Read framebuffer attributes of window to fb_config
+ */
+extern void __gtkglut_fb_config_snapshot(__gtkglut_window_struct * glut_window);
+
+/*
+ * Store position of window and all its childs to geometry cache
+ */
+extern void __gtkglut_cache_window_position(__gtkglut_window_struct * glut_window, int x, int y);
+
+/*
+ * Create and attach source executing requests posted from other threads
+ */
+extern GSource *__gtkglut_thread_source_new(void);
+
+/*
+ * Enable or disable skipping of redisplay of hidden windows
+ */
+extern void __gtkglut_set_skip_hidden_redisplay(int value);
+extern void __gtkglut_set_pointer_cache(int value);
+extern void __gtkglut_set_event_dispatch(int value);
+extern void __gtkglut_keysym_table_init(void);
+
+/*
+ * GDK event handler, dispatching input events of GtkGLUT windows
+ */
+extern void __gtkglut_event_dispatch(GdkEvent * event, gpointer data);
+
+/*
+ * Rebuild event table of window from registered callbacks, connect or disconnect
+ * GTK+ signals if event dispatcher is disabled
+ */
+extern void __gtkglut_window_events_update(__gtkglut_window_struct * glut_window, int window_id);
+
+/*
+ * Set policy of idle callback (GTKGLUT_IDLE_*)
+ */
+extern void __gtkglut_set_idle_policy(int policy);
+
+/*
+ * Deliver compressed motion of window
+ */
+extern void __gtkglut_flush_window_motion(int window_id);
+
+/*
+ * Arm new timer (period 0 for one shot timer). Returns timer handle or 0.
+ */
+extern int __gtkglut_timer_add(unsigned int msecs, unsigned int period,
+    void (*func) (int value), int value);
+
+/*
+ * Cancel timer. Returns TRUE if timer was armed.
+ */
+extern gboolean __gtkglut_timer_cancel(int handle);
+
+/*
+ * Arm new precise timer with times in microseconds. Returns timer handle or 0.
+ */
+extern int __gtkglut_timer_add_precise(gint64 usecs, gint64 period,
+    void (*func) (int value), int value);
+
+/*
+ * Microseconds till nearest timer or -1 if there is no timer
+ */
+extern gint64 __gtkglut_timer_next_wakeup(void);
+
+/*
+ * TRUE, if precise timers wake up main loop without polling (timerfd)
+ */
+extern gboolean __gtkglut_timer_precise_wakeup(void);
+
+/*
+ * Monotonic time in microseconds and nanoseconds
+ */
+extern gint64 __gtkglut_get_time_usec(void);
+extern gint64 __gtkglut_get_time_nsec(void);
+
+/*
+ * Frame statistics hooks. Begin and end surround display callback, swap is
+ * called from glutSwapBuffers. All need current GL context of window.
+ */
+extern void __gtkglut_frame_stats_begin(__gtkglut_window_struct * glut_window);
+extern void __gtkglut_frame_stats_end(__gtkglut_window_struct * glut_window, int window_id);
+extern void __gtkglut_frame_stats_swap(__gtkglut_window_struct * glut_window);
+
+/*
+ * Free frame statistics of window. Timer queries are deleted only if GL context
+ * of window is current (in_context).
+ */
+extern void __gtkglut_frame_stats_free(__gtkglut_window_struct * glut_window,
+    gboolean in_context);
+
+/*
+ * Average of frame statistics value of window in microseconds, -1 if there is no sample
+ */
+extern int __gtkglut_frame_stats_get_avg(__gtkglut_window_struct * glut_window, int state);
+
+/*
+ * Draw built-in shape from mesh cache, scaled by sx, sy, sz. Mesh is built by
+ * generator, if it is not cached yet. Returns FALSE, if cache is disabled or
+ * shape can't be cached, and caller must draw shape itself.
+ */
+extern gboolean __gtkglut_mesh_draw(int shape, GLfloat param, int slices, int stacks,
+    gboolean solid, __gtkglut_mesh_generator generator, GLdouble sx, GLdouble sy, GLdouble sz);
+
+/*
+ * Draw count instances of built-in shape. Instance is scaled by sx, sy, sz,
+ * transformed by its matrix (16 floats) and optionally colored (4 floats).
+ * Uses ARB_draw_instanced if possible, otherwise loop over client arrays.
+ */
+extern void __gtkglut_mesh_draw_instanced(int shape, GLfloat param, int slices, int stacks,
+    gboolean solid, __gtkglut_mesh_generator generator, GLdouble sx, GLdouble sy, GLdouble sz,
+    int count, const GLfloat * matrices, const GLfloat * colors);
+
+/*
+ * Drop meshes and instancing program of GL context, when its window is going to be
+ * destroyed. GL objects are deleted only if context is current (in_context).
+ */
+extern void __gtkglut_mesh_cache_purge(GdkGLContext * gl_context, gboolean in_context);
+
+/*
+ * Drop frame fences of window, sync objects are deleted only if in_context
+ */
+extern void __gtkglut_frame_fences_delete(__gtkglut_window_struct * glut_window,
+    gboolean in_context);
+
 /*
  * Regenerate menu
  */
@@ -36,24 +36,20 @@
 #include "gtkglut_internal.h"
 
 /*
- * Append glut_menu to context menu array
+ * Add glut_menu to context menu array. Returns menu id.
  */
-void __gtkglut_menu_array_append(__gtkglut_menu_struct * glut_menu)
+int __gtkglut_menu_array_append(__gtkglut_menu_struct * glut_menu)
 {
+	int menu_id;
 
-	if (!__gtkglut_context->menu_array) {
-		__gtkglut_context->menu_array = g_ptr_array_new();
-
-		if (!__gtkglut_context->menu_array)
-			__gtkglut_lowmem();
+	menu_id = __gtkglut_id_table_add(&__gtkglut_context->menu_array,
+					 &__gtkglut_context->menu_ids,
+					 &__gtkglut_context->menu_free_slots, glut_menu);
 
-		/*
-		 * Because GLUT start numbering from 1, we do this same way
-		 */
-		g_ptr_array_add(__gtkglut_context->menu_array, NULL);
-	}
+	if (!menu_id)
+		__gtkglut_error("__gtkglut_menu_array_append", "too many menus");
 
-	g_ptr_array_add(__gtkglut_context->menu_array, glut_menu);
+	return menu_id;
 }
 
 /*
@@ -61,13 +57,9 @@ void __gtkglut_menu_array_append(__gtkglut_menu_struct * glut_menu)
  */
 __gtkglut_menu_struct *__gtkglut_get_menu_by_id(int menu_id)
 {
-
-	if (menu_id < 0 || !__gtkglut_context->menu_array
-	    || (guint) menu_id >= __gtkglut_context->menu_array->len) {
-		return NULL;
-	}
-
-	return (__gtkglut_menu_struct *) g_ptr_array_index(__gtkglut_context->menu_array, menu_id);
+	return (__gtkglut_menu_struct *) __gtkglut_id_table_get(__gtkglut_context->menu_array,
+								__gtkglut_context->menu_ids,
+								menu_id);
 }
 
 /*!
@@ -157,7 +149,8 @@ void glutSetMenu(int menu)
 
 	__gtkglut_test_inicialization("glutSetMenu");
 
-	if (menu < 1 || (guint) menu >= __gtkglut_context->menu_array->len) {
+	if (menu < 1 || !__gtkglut_context->menu_array
+	    || (guint) __GTKGLUT_ID_SLOT(menu) >= __gtkglut_context->menu_array->len) {
 		__gtkglut_warning("glutSetMenu", "Attempted on bogus menu %d!", menu);
 		return;
 	}
@@ -308,9 +301,7 @@ int glutCreateMenu(void (*func) (int value))
 	glut_menu->parent_menus = NULL;
 	glut_menu->user_data = NULL;
 
-	__gtkglut_menu_array_append(glut_menu);
-
-	menu_id = __gtkglut_context->menu_array->len - 1;
+	menu_id = __gtkglut_menu_array_append(glut_menu);
 
 	glutSetMenu(menu_id);
 
@@ -378,7 +369,8 @@ void glutDestroyMenu(int menu)
 		/*
 		 * Unlink from array, destroy data structure
 		 */
-		g_ptr_array_index(__gtkglut_context->menu_array, menu) = NULL;
+		__gtkglut_id_table_remove(__gtkglut_context->menu_array,
+					  __gtkglut_context->menu_free_slots, menu);
 
 		if (glut_menu->parent_menus)
 			__gtkglut_refset_destroy(glut_menu->parent_menus);
@@ -779,9 +771,9 @@ void glutAttachMenu(int button)
 			return;
 		}
 
-		__gtkglut_register_mouse_func(glut_window);
-
 		glut_window->mouse_button_menu[button] = glutGetMenu();
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -829,9 +821,9 @@ void glutDetachMenu(int button)
 		/*
 		 * Real detach
 		 */
-		__gtkglut_unregister_mouse_func(glut_window, button);
-
 		glut_window->mouse_button_menu[button] = 0;
+
+		__gtkglut_window_events_update(glut_window, glutGetWindow());
 	}
 }
 
@@ -0,0 +1,894 @@
+/*!
+ * \file  gtkglut_mesh.c
+ * \brief GtkGLUT mesh cache of built-in shapes.
+ */
+
+/*
+ * GtkGLUT mesh cache of built-in shapes.
+ *
+ * Copyright (c) 2008-2026 Jan Friesse. All Rights Reserved.
+ * Written by Jan Friesse, <jfriesse@gmail.comt>
+ * Creation date: Sat Oct 17 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Except as contained in this notice, the name of Jan Friesse shall not be
+ * used in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Jan Friesse.
+ */
+
+#include "GL/gtkglut.h"
+#include "gtkglut_internal.h"
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+
+#ifndef GL_LIGHT_MODEL_COLOR_CONTROL
+#define GL_LIGHT_MODEL_COLOR_CONTROL 0x81F8
+#define GL_SINGLE_COLOR 0x81F9
+#endif
+
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+#ifndef GL_CURRENT_PROGRAM
+#define GL_CURRENT_PROGRAM 0x8B8D
+#endif
+
+/*
+ * Size of one vertex (normal and position) in bytes
+ */
+#define __GTKGLUT_MESH_VERTEX_SIZE (6 * sizeof(GLfloat))
+
+static guint __gtkglut_mesh_key_hash(gconstpointer key)
+{
+	const __gtkglut_mesh_key_struct *mesh_key;
+	guint32 param;
+	guint hash;
+
+	mesh_key = (const __gtkglut_mesh_key_struct *)key;
+
+	memcpy(&param, &mesh_key->param, sizeof(param));
+
+	hash = GPOINTER_TO_UINT(mesh_key->gl_context);
+	hash = hash * 31 + mesh_key->shape;
+	hash = hash * 31 + param;
+	hash = hash * 31 + mesh_key->slices;
+	hash = hash * 31 + mesh_key->stacks;
+	hash = hash * 31 + mesh_key->solid;
+
+	return hash;
+}
+
+static gboolean __gtkglut_mesh_key_equal(gconstpointer a, gconstpointer b)
+{
+	const __gtkglut_mesh_key_struct *ka;
+	const __gtkglut_mesh_key_struct *kb;
+
+	ka = (const __gtkglut_mesh_key_struct *)a;
+	kb = (const __gtkglut_mesh_key_struct *)b;
+
+	return ka->gl_context == kb->gl_context && ka->shape == kb->shape &&
+	    ka->param == kb->param && ka->slices == kb->slices && ka->stacks == kb->stacks &&
+	    ka->solid == kb->solid;
+}
+
+/*
+ * Resolve ARB_vertex_buffer_object functions. Must be called with current GL context.
+ */
+static void __gtkglut_buffer_objects_init(void)
+{
+	__gtkglut_context->buffer_objects_supported = FALSE;
+
+	if (!gdk_gl_query_gl_extension("GL_ARB_vertex_buffer_object"))
+		return;
+
+	__gtkglut_context->gl_gen_buffers = (void (APIENTRY *) (GLsizei, GLuint *))
+	    glutGetProcAddress("glGenBuffersARB");
+	__gtkglut_context->gl_bind_buffer = (void (APIENTRY *) (GLenum, GLuint))
+	    glutGetProcAddress("glBindBufferARB");
+	__gtkglut_context->gl_buffer_data =
+	    (void (APIENTRY *) (GLenum, gssize, const GLvoid *, GLenum))
+	    glutGetProcAddress("glBufferDataARB");
+	__gtkglut_context->gl_delete_buffers = (void (APIENTRY *) (GLsizei, const GLuint *))
+	    glutGetProcAddress("glDeleteBuffersARB");
+
+	__gtkglut_context->buffer_objects_supported = __gtkglut_context->gl_gen_buffers &&
+	    __gtkglut_context->gl_bind_buffer && __gtkglut_context->gl_buffer_data &&
+	    __gtkglut_context->gl_delete_buffers;
+}
+
+static void __gtkglut_mesh_lru_unlink(__gtkglut_mesh_struct * mesh)
+{
+	if (mesh->prev)
+		mesh->prev->next = mesh->next;
+	else
+		__gtkglut_context->mesh_lru_first = mesh->next;
+
+	if (mesh->next)
+		mesh->next->prev = mesh->prev;
+	else
+		__gtkglut_context->mesh_lru_last = mesh->prev;
+
+	mesh->prev = mesh->next = NULL;
+}
+
+static void __gtkglut_mesh_lru_push(__gtkglut_mesh_struct * mesh)
+{
+	mesh->prev = NULL;
+	mesh->next = __gtkglut_context->mesh_lru_first;
+
+	if (mesh->next)
+		mesh->next->prev = mesh;
+	else
+		__gtkglut_context->mesh_lru_last = mesh;
+
+	__gtkglut_context->mesh_lru_first = mesh;
+}
+
+/*
+ * Remove mesh from cache and free it. GL context of mesh must be current,
+ * if delete_buffers is TRUE.
+ */
+static void __gtkglut_mesh_free(__gtkglut_mesh_struct * mesh, gboolean delete_buffers)
+{
+	g_hash_table_remove(__gtkglut_context->mesh_cache, &mesh->key);
+	__gtkglut_mesh_lru_unlink(mesh);
+
+	__gtkglut_context->mesh_cache_used -= mesh->size;
+
+	if (delete_buffers && mesh->buffers[0])
+		__gtkglut_context->gl_delete_buffers(2, mesh->buffers);
+
+	free(mesh->vertices);
+	free(mesh->indices);
+	free(mesh);
+}
+
+/*
+ * Evict least recently used meshes of current GL context, until size bytes
+ * fits under limit. Meshes of other contexts can't be deleted now, so nothing
+ * is evicted, if they alone leave not enough space. Returns TRUE, if there is
+ * enough space.
+ */
+static gboolean __gtkglut_mesh_cache_evict(gsize size)
+{
+	__gtkglut_mesh_struct *mesh;
+	__gtkglut_mesh_struct *prev;
+	gsize used_other;
+
+	if (size > __gtkglut_context->mesh_cache_limit)
+		return FALSE;
+
+	used_other = 0;
+
+	for (mesh = __gtkglut_context->mesh_lru_first; mesh; mesh = mesh->next) {
+		if (mesh->key.gl_context != __gtkglut_context->current_gl_context)
+			used_other += mesh->size;
+	}
+
+	if (used_other + size > __gtkglut_context->mesh_cache_limit)
+		return FALSE;
+
+	mesh = __gtkglut_context->mesh_lru_last;
+
+	while (mesh
+	       && __gtkglut_context->mesh_cache_used + size > __gtkglut_context->mesh_cache_limit) {
+		prev = mesh->prev;
+
+		if (mesh->key.gl_context == __gtkglut_context->current_gl_context)
+			__gtkglut_mesh_free(mesh, TRUE);
+
+		mesh = prev;
+	}
+
+	return __gtkglut_context->mesh_cache_used + size <= __gtkglut_context->mesh_cache_limit;
+}
+
+/*
+ * Store generated data to new cache entry. Data are moved to buffer objects,
+ * if they are supported, otherwise mesh takes ownership of data arrays.
+ */
+static __gtkglut_mesh_struct *__gtkglut_mesh_insert(const __gtkglut_mesh_key_struct * key,
+						    __gtkglut_mesh_data_struct * data, gsize size)
+{
+	__gtkglut_mesh_struct *mesh;
+
+	mesh = (__gtkglut_mesh_struct *) malloc(sizeof(__gtkglut_mesh_struct));
+
+	if (!mesh)
+		__gtkglut_lowmem();
+
+	mesh->key = *key;
+	mesh->num_indices = data->num_indices;
+	mesh->mode = data->mode;
+	mesh->size = size;
+	mesh->buffers[0] = mesh->buffers[1] = 0;
+
+	if (__gtkglut_context->buffer_objects_supported) {
+		__gtkglut_context->gl_gen_buffers(2, mesh->buffers);
+
+		__gtkglut_context->gl_bind_buffer(GL_ARRAY_BUFFER, mesh->buffers[0]);
+		__gtkglut_context->gl_buffer_data(GL_ARRAY_BUFFER,
+						  data->num_vertices * __GTKGLUT_MESH_VERTEX_SIZE,
+						  data->vertices, GL_STATIC_DRAW);
+		__gtkglut_context->gl_bind_buffer(GL_ARRAY_BUFFER, 0);
+
+		__gtkglut_context->gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, mesh->buffers[1]);
+		__gtkglut_context->gl_buffer_data(GL_ELEMENT_ARRAY_BUFFER,
+						  data->num_indices * sizeof(GLuint),
+						  data->indices, GL_STATIC_DRAW);
+		__gtkglut_context->gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		free(data->vertices);
+		free(data->indices);
+		mesh->vertices = NULL;
+		mesh->indices = NULL;
+	} else {
+		mesh->vertices = data->vertices;
+		mesh->indices = data->indices;
+	}
+
+	data->vertices = NULL;
+	data->indices = NULL;
+
+	g_hash_table_insert(__gtkglut_context->mesh_cache, &mesh->key, mesh);
+	__gtkglut_mesh_lru_push(mesh);
+	__gtkglut_context->mesh_cache_used += size;
+
+	return mesh;
+}
+
+/*
+ * Size of mesh data in cache
+ */
+static gsize __gtkglut_mesh_size(const __gtkglut_mesh_data_struct * data)
+{
+
+	return data->num_vertices * __GTKGLUT_MESH_VERTEX_SIZE +
+	    data->num_indices * sizeof(GLuint) + sizeof(__gtkglut_mesh_struct);
+}
+
+/*
+ * Return cached mesh, build it if needed. Mesh is measured before it's built,
+ * so mesh which can't be cached (cache is disabled or mesh doesn't fit under
+ * limit) is built only into tmp_mesh for allow_tmp callers, otherwise NULL
+ * is returned. Temporary mesh must be released by __gtkglut_mesh_release.
+ */
+static __gtkglut_mesh_struct *__gtkglut_mesh_acquire(int shape, GLfloat param, int slices,
+						     int stacks, gboolean solid,
+						     __gtkglut_mesh_generator generator,
+						     __gtkglut_mesh_struct * tmp_mesh,
+						     gboolean allow_tmp)
+{
+	__gtkglut_mesh_key_struct key;
+	__gtkglut_mesh_data_struct data;
+	__gtkglut_mesh_struct *mesh;
+
+	if (!__gtkglut_context->mesh_cache_limit) {
+		if (!allow_tmp)
+			return NULL;
+	} else {
+		key.gl_context = __gtkglut_context->current_gl_context;
+		key.shape = shape;
+		key.param = param;
+		key.slices = slices;
+		key.stacks = stacks;
+		key.solid = solid;
+
+		if (!__gtkglut_context->mesh_cache) {
+			__gtkglut_context->mesh_cache = g_hash_table_new(__gtkglut_mesh_key_hash,
+									 __gtkglut_mesh_key_equal);
+		}
+
+		mesh = (__gtkglut_mesh_struct *) g_hash_table_lookup(__gtkglut_context->mesh_cache,
+								       &key);
+
+		if (mesh) {
+			if (mesh != __gtkglut_context->mesh_lru_first) {
+				__gtkglut_mesh_lru_unlink(mesh);
+				__gtkglut_mesh_lru_push(mesh);
+			}
+
+			return mesh;
+		}
+
+		if (__gtkglut_context->buffer_objects_supported == __GTKGLUT_UNDEFINED)
+			__gtkglut_buffer_objects_init();
+
+		data.measure = TRUE;
+		generator(&data, param, slices, stacks, solid);
+
+		if (__gtkglut_mesh_cache_evict(__gtkglut_mesh_size(&data))) {
+			data.measure = FALSE;
+			generator(&data, param, slices, stacks, solid);
+
+			return __gtkglut_mesh_insert(&key, &data, __gtkglut_mesh_size(&data));
+		}
+
+		/*
+		 * Generating mesh, which is drawn once and thrown away, is slower than
+		 * immediate mode
+		 */
+		if (!allow_tmp)
+			return NULL;
+	}
+
+	/*
+	 * Not cached -> draw from client arrays
+	 */
+	data.measure = FALSE;
+	generator(&data, param, slices, stacks, solid);
+
+	tmp_mesh->buffers[0] = tmp_mesh->buffers[1] = 0;
+	tmp_mesh->vertices = data.vertices;
+	tmp_mesh->indices = data.indices;
+	tmp_mesh->num_indices = data.num_indices;
+	tmp_mesh->mode = data.mode;
+
+	return tmp_mesh;
+}
+
+static void __gtkglut_mesh_release(__gtkglut_mesh_struct * mesh, __gtkglut_mesh_struct * tmp_mesh)
+{
+	if (mesh == tmp_mesh) {
+		free(mesh->vertices);
+		free(mesh->indices);
+	}
+}
+
+/*
+ * Save client vertex array state and set normal and vertex arrays of mesh.
+ * Returns pointer to indices for glDrawElements.
+ */
+static const GLuint *__gtkglut_mesh_bind(__gtkglut_mesh_struct * mesh)
+{
+	const GLfloat *vertices;
+	const GLuint *indices;
+
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+	if (mesh->buffers[0]) {
+		__gtkglut_context->gl_bind_buffer(GL_ARRAY_BUFFER, mesh->buffers[0]);
+		__gtkglut_context->gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, mesh->buffers[1]);
+		vertices = NULL;
+		indices = NULL;
+	} else {
+		vertices = mesh->vertices;
+		indices = mesh->indices;
+	}
+
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glNormalPointer(GL_FLOAT, __GTKGLUT_MESH_VERTEX_SIZE, vertices);
+	glVertexPointer(3, GL_FLOAT, __GTKGLUT_MESH_VERTEX_SIZE, vertices + 3);
+
+	return indices;
+}
+
+/*
+ * Restore client vertex array state. Buffer bindings are part of it.
+ */
+static void __gtkglut_mesh_unbind(void)
+{
+	glPopClientAttrib();
+}
+
+gboolean __gtkglut_mesh_draw(int shape, GLfloat param, int slices, int stacks,
+			     gboolean solid, __gtkglut_mesh_generator generator,
+			     GLdouble sx, GLdouble sy, GLdouble sz)
+{
+	__gtkglut_mesh_struct tmp_mesh;
+	__gtkglut_mesh_struct *mesh;
+	const GLuint *indices;
+	gboolean normalize;
+
+	if (!__gtkglut_context->current_gl_context)
+		return FALSE;
+
+	if (slices < 1 || stacks < 1
+	    || (gint64) (slices + 1) * (stacks + 1) > __GTKGLUT_MESH_MAX_VERTICES)
+		return FALSE;
+
+	mesh = __gtkglut_mesh_acquire(shape, param, slices, stacks, solid, generator, &tmp_mesh,
+				      FALSE);
+
+	if (!mesh)
+		return FALSE;
+
+	glPushMatrix();
+	glScaled(sx, sy, sz);
+
+	/*
+	 * Normals of unit mesh must be renormalized after scale
+	 */
+	normalize = !(sx == 1.0 && sy == 1.0 && sz == 1.0) && !glIsEnabled(GL_NORMALIZE);
+
+	if (normalize)
+		glEnable(GL_NORMALIZE);
+
+	indices = __gtkglut_mesh_bind(mesh);
+	glDrawElements(mesh->mode, mesh->num_indices, GL_UNSIGNED_INT, indices);
+	__gtkglut_mesh_unbind();
+
+	if (normalize)
+		glDisable(GL_NORMALIZE);
+
+	glPopMatrix();
+
+	__gtkglut_mesh_release(mesh, &tmp_mesh);
+
+	return TRUE;
+}
+
+/*
+ * Vertex shader of instanced shapes. Instance matrix and color come from
+ * instanced attributes, lighting emulates fixed function pipeline (one
+ * sided, infinite viewer, no separate specular color).
+ */
+static const char *__gtkglut_instanced_shader =
+    "#version 120\n"
+    "attribute vec4 instance_m0;\n"
+    "attribute vec4 instance_m1;\n"
+    "attribute vec4 instance_m2;\n"
+    "attribute vec4 instance_m3;\n"
+    "attribute vec4 instance_color;\n"
+    "uniform vec3 scale;\n"
+    "uniform int instance_colors;\n"
+    "uniform int lighting;\n"
+    "uniform int color_material;\n"
+    "uniform int lights[8];\n"
+    "void main(void)\n"
+    "{\n"
+    "  mat4 m = mat4(instance_m0, instance_m1, instance_m2, instance_m3);\n"
+    "  vec4 ec = gl_ModelViewMatrix * (m * vec4(gl_Vertex.xyz * scale, 1.0));\n"
+    "  vec4 color = (instance_colors != 0) ? instance_color : gl_Color;\n"
+    "  gl_Position = gl_ProjectionMatrix * ec;\n"
+    "  gl_ClipVertex = ec;\n"
+    "  gl_FogFragCoord = abs(ec.z);\n"
+    "  if (lighting == 0) {\n"
+    "    gl_FrontColor = color;\n"
+    "    return;\n"
+    "  }\n"
+    /* Cofactor matrix is inverse transpose multiplied by determinant */
+    "  vec3 c0 = cross(m[1].xyz, m[2].xyz);\n"
+    "  vec3 c1 = cross(m[2].xyz, m[0].xyz);\n"
+    "  vec3 c2 = cross(m[0].xyz, m[1].xyz);\n"
+    "  vec3 n = mat3(c0, c1, c2) * (gl_Normal / scale);\n"
+    "  n = normalize(gl_NormalMatrix * n * sign(dot(m[0].xyz, c0)));\n"
+    "  vec4 amb = (color_material == 2) ? color : gl_FrontMaterial.ambient;\n"
+    "  vec4 dif = (color_material != 0) ? color : gl_FrontMaterial.diffuse;\n"
+    "  vec4 c = gl_FrontMaterial.emission + amb * gl_LightModel.ambient;\n"
+    "  for (int i = 0; i < 8; i++) {\n"
+    "    if (lights[i] == 0)\n"
+    "      continue;\n"
+    "    vec3 l = gl_LightSource[i].position.xyz;\n"
+    "    float att = 1.0;\n"
+    "    if (gl_LightSource[i].position.w != 0.0) {\n"
+    "      l -= ec.xyz;\n"
+    "      float d = length(l);\n"
+    "      att = 1.0 / (gl_LightSource[i].constantAttenuation +\n"
+    "        gl_LightSource[i].linearAttenuation * d +\n"
+    "        gl_LightSource[i].quadraticAttenuation * d * d);\n"
+    "      if (gl_LightSource[i].spotCutoff != 180.0) {\n"
+    "        float s = dot(-normalize(l), normalize(gl_LightSource[i].spotDirection));\n"
+    "        att *= (s < gl_LightSource[i].spotCosCutoff) ? 0.0 :\n"
+    "          pow(s, gl_LightSource[i].spotExponent);\n"
+    "      }\n"
+    "    }\n"
+    "    l = normalize(l);\n"
+    "    float nl = max(dot(n, l), 0.0);\n"
+    "    c += att * (amb * gl_LightSource[i].ambient + nl * dif * gl_LightSource[i].diffuse);\n"
+    "    if (nl > 0.0)\n"
+    "      c += att * pow(max(dot(n, normalize(l + vec3(0.0, 0.0, 1.0))), 0.0),\n"
+    "        gl_FrontMaterial.shininess) * gl_FrontMaterial.specular *\n"
+    "        gl_LightSource[i].specular;\n"
+    "  }\n"
+    "  gl_FrontColor = vec4(c.rgb, dif.a);\n"
+    "}\n";
+
+/*
+ * Location of first instance attribute (matrix takes 4 locations, color is
+ * after matrix). NVIDIA aliases generic attributes with conventional ones
+ * (0 vertex, 2 normal, 3 color, 4 secondary color, 5 fog, 8 - 15 texture
+ * coordinates), so instance attributes start at 6 and only overlap texture
+ * coordinates, which shader doesn't read.
+ */
+#define __GTKGLUT_INSTANCE_ATTRIB 6
+
+/*
+ * Resolve GL 2.0 shader, ARB_instanced_arrays and ARB_draw_instanced functions.
+ * Must be called with current GL context.
+ */
+static void __gtkglut_instancing_init(void)
+{
+	__gtkglut_instancing_funcs_struct *funcs;
+	const char *version;
+
+	funcs = &__gtkglut_context->instancing_funcs;
+
+	__gtkglut_context->instancing_supported = FALSE;
+
+	version = (const char *)glGetString(GL_VERSION);
+
+	if (!version || version[0] < '2' || version[1] != '.'
+	    || !gdk_gl_query_gl_extension("GL_ARB_instanced_arrays")
+	    || !gdk_gl_query_gl_extension("GL_ARB_draw_instanced"))
+		return;
+
+	funcs->create_shader = (GLuint(APIENTRY *) (GLenum))glutGetProcAddress("glCreateShader");
+	funcs->shader_source = (void (APIENTRY *) (GLuint, GLsizei, const char **, const GLint *))
+	    glutGetProcAddress("glShaderSource");
+	funcs->compile_shader = (void (APIENTRY *) (GLuint))glutGetProcAddress("glCompileShader");
+	funcs->get_shaderiv = (void (APIENTRY *) (GLuint, GLenum, GLint *))
+	    glutGetProcAddress("glGetShaderiv");
+	funcs->delete_shader = (void (APIENTRY *) (GLuint))glutGetProcAddress("glDeleteShader");
+	funcs->create_program = (GLuint(APIENTRY *) (void))
+	    glutGetProcAddress("glCreateProgram");
+	funcs->attach_shader = (void (APIENTRY *) (GLuint, GLuint))
+	    glutGetProcAddress("glAttachShader");
+	funcs->bind_attrib_location = (void (APIENTRY *) (GLuint, GLuint, const char *))
+	    glutGetProcAddress("glBindAttribLocation");
+	funcs->link_program = (void (APIENTRY *) (GLuint))glutGetProcAddress("glLinkProgram");
+	funcs->get_programiv = (void (APIENTRY *) (GLuint, GLenum, GLint *))
+	    glutGetProcAddress("glGetProgramiv");
+	funcs->delete_program = (void (APIENTRY *) (GLuint))
+	    glutGetProcAddress("glDeleteProgram");
+	funcs->use_program = (void (APIENTRY *) (GLuint))glutGetProcAddress("glUseProgram");
+	funcs->get_uniform_location = (GLint(APIENTRY *) (GLuint, const char *))
+	    glutGetProcAddress("glGetUniformLocation");
+	funcs->uniform1i = (void (APIENTRY *) (GLint, GLint))glutGetProcAddress("glUniform1i");
+	funcs->uniform1iv = (void (APIENTRY *) (GLint, GLsizei, const GLint *))
+	    glutGetProcAddress("glUniform1iv");
+	funcs->uniform3f = (void (APIENTRY *) (GLint, GLfloat, GLfloat, GLfloat))
+	    glutGetProcAddress("glUniform3f");
+	funcs->vertex_attrib_pointer =
+	    (void (APIENTRY *) (GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid *))
+	    glutGetProcAddress("glVertexAttribPointer");
+	funcs->enable_vertex_attrib_array = (void (APIENTRY *) (GLuint))
+	    glutGetProcAddress("glEnableVertexAttribArray");
+	funcs->disable_vertex_attrib_array = (void (APIENTRY *) (GLuint))
+	    glutGetProcAddress("glDisableVertexAttribArray");
+	funcs->vertex_attrib_divisor = (void (APIENTRY *) (GLuint, GLuint))
+	    glutGetProcAddress("glVertexAttribDivisorARB");
+	funcs->draw_elements_instanced =
+	    (void (APIENTRY *) (GLenum, GLsizei, GLenum, const GLvoid *, GLsizei))
+	    glutGetProcAddress("glDrawElementsInstancedARB");
+
+	__gtkglut_context->instancing_supported = funcs->create_shader && funcs->shader_source &&
+	    funcs->compile_shader && funcs->get_shaderiv && funcs->delete_shader &&
+	    funcs->create_program && funcs->attach_shader && funcs->bind_attrib_location &&
+	    funcs->link_program && funcs->get_programiv && funcs->delete_program &&
+	    funcs->use_program && funcs->get_uniform_location && funcs->uniform1i &&
+	    funcs->uniform1iv && funcs->uniform3f && funcs->vertex_attrib_pointer &&
+	    funcs->enable_vertex_attrib_array && funcs->disable_vertex_attrib_array &&
+	    funcs->vertex_attrib_divisor && funcs->draw_elements_instanced;
+}
+
+/*
+ * Return instancing program of current GL context, build it if needed.
+ * Returns NULL, if program can't be built.
+ */
+static __gtkglut_instanced_program_struct *__gtkglut_instanced_program_get(void)
+{
+	__gtkglut_instancing_funcs_struct *funcs;
+	__gtkglut_instanced_program_struct *program;
+	GLuint shader;
+	GLint status;
+
+	if (!__gtkglut_context->instanced_programs)
+		__gtkglut_context->instanced_programs = g_hash_table_new(NULL, NULL);
+
+	program = (__gtkglut_instanced_program_struct *)
+	    g_hash_table_lookup(__gtkglut_context->instanced_programs,
+				__gtkglut_context->current_gl_context);
+
+	if (program)
+		return program;
+
+	funcs = &__gtkglut_context->instancing_funcs;
+
+	shader = funcs->create_shader(GL_VERTEX_SHADER);
+	funcs->shader_source(shader, 1, &__gtkglut_instanced_shader, NULL);
+	funcs->compile_shader(shader);
+	funcs->get_shaderiv(shader, GL_COMPILE_STATUS, &status);
+
+	if (!status) {
+		funcs->delete_shader(shader);
+		__gtkglut_warning("instanced drawing", "can't compile vertex shader");
+		__gtkglut_context->instancing_supported = FALSE;
+
+		return NULL;
+	}
+
+	program = (__gtkglut_instanced_program_struct *)
+	    malloc(sizeof(__gtkglut_instanced_program_struct));
+
+	if (!program)
+		__gtkglut_lowmem();
+
+	program->program = funcs->create_program();
+	funcs->attach_shader(program->program, shader);
+	funcs->bind_attrib_location(program->program, __GTKGLUT_INSTANCE_ATTRIB, "instance_m0");
+	funcs->bind_attrib_location(program->program, __GTKGLUT_INSTANCE_ATTRIB + 1,
+				    "instance_m1");
+	funcs->bind_attrib_location(program->program, __GTKGLUT_INSTANCE_ATTRIB + 2,
+				    "instance_m2");
+	funcs->bind_attrib_location(program->program, __GTKGLUT_INSTANCE_ATTRIB + 3,
+				    "instance_m3");
+	funcs->bind_attrib_location(program->program, __GTKGLUT_INSTANCE_ATTRIB + 4,
+				    "instance_color");
+	funcs->link_program(program->program);
+
+	/*
+	 * Shader is deleted together with program
+	 */
+	funcs->delete_shader(shader);
+
+	funcs->get_programiv(program->program, GL_LINK_STATUS, &status);
+
+	if (!status) {
+		funcs->delete_program(program->program);
+		free(program);
+		__gtkglut_warning("instanced drawing", "can't link shader program");
+		__gtkglut_context->instancing_supported = FALSE;
+
+		return NULL;
+	}
+
+	program->scale = funcs->get_uniform_location(program->program, "scale");
+	program->instance_colors = funcs->get_uniform_location(program->program,
+							       "instance_colors");
+	program->lighting = funcs->get_uniform_location(program->program, "lighting");
+	program->color_material = funcs->get_uniform_location(program->program,
+							      "color_material");
+	program->lights = funcs->get_uniform_location(program->program, "lights");
+
+	g_hash_table_insert(__gtkglut_context->instanced_programs,
+			    __gtkglut_context->current_gl_context, program);
+
+	return program;
+}
+
+/*
+ * Set lighting uniforms from fixed function state. Returns FALSE, if state
+ * can't be emulated by instancing shader.
+ */
+static gboolean __gtkglut_instanced_lighting(__gtkglut_instanced_program_struct * program)
+{
+	GLint lights[8];
+	GLint value;
+	int i;
+
+	if (!glIsEnabled(GL_LIGHTING)) {
+		__gtkglut_context->instancing_funcs.uniform1i(program->lighting, 0);
+		return TRUE;
+	}
+
+	glGetIntegerv(GL_LIGHT_MODEL_TWO_SIDE, &value);
+	if (value)
+		return FALSE;
+
+	glGetIntegerv(GL_LIGHT_MODEL_LOCAL_VIEWER, &value);
+	if (value)
+		return FALSE;
+
+	glGetIntegerv(GL_LIGHT_MODEL_COLOR_CONTROL, &value);
+	if (value != GL_SINGLE_COLOR)
+		return FALSE;
+
+	value = 0;
+
+	if (glIsEnabled(GL_COLOR_MATERIAL)) {
+		glGetIntegerv(GL_COLOR_MATERIAL_PARAMETER, &value);
+
+		if (value == GL_AMBIENT_AND_DIFFUSE)
+			value = 2;
+		else if (value == GL_DIFFUSE)
+			value = 1;
+		else
+			return FALSE;
+	}
+
+	for (i = 0; i < 8; i++)
+		lights[i] = glIsEnabled(GL_LIGHT0 + i);
+
+	__gtkglut_context->instancing_funcs.uniform1i(program->lighting, 1);
+	__gtkglut_context->instancing_funcs.uniform1i(program->color_material, value);
+	__gtkglut_context->instancing_funcs.uniform1iv(program->lights, 8, lights);
+
+	return TRUE;
+}
+
+/*
+ * Draw instances by ARB_draw_instanced. Mesh arrays must be already bound.
+ * Returns FALSE, if instancing can't be used.
+ */
+static gboolean __gtkglut_mesh_draw_instanced_arb(__gtkglut_mesh_struct * mesh,
+						  const GLuint * indices, GLdouble sx,
+						  GLdouble sy, GLdouble sz, int count,
+						  const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_instancing_funcs_struct *funcs;
+	__gtkglut_instanced_program_struct *program;
+	GLint old_program;
+	GLuint attrib;
+	int i;
+
+	if (__gtkglut_context->instancing_supported == __GTKGLUT_UNDEFINED)
+		__gtkglut_instancing_init();
+
+	if (!__gtkglut_context->instancing_supported)
+		return FALSE;
+
+	program = __gtkglut_instanced_program_get();
+
+	if (!program)
+		return FALSE;
+
+	funcs = &__gtkglut_context->instancing_funcs;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &old_program);
+	funcs->use_program(program->program);
+
+	if (!__gtkglut_instanced_lighting(program)) {
+		funcs->use_program((GLuint) old_program);
+		return FALSE;
+	}
+
+	funcs->uniform3f(program->scale, (GLfloat) sx, (GLfloat) sy, (GLfloat) sz);
+	funcs->uniform1i(program->instance_colors, colors != NULL);
+
+	/*
+	 * Instance attributes are client arrays
+	 */
+	if (mesh->buffers[0])
+		__gtkglut_context->gl_bind_buffer(GL_ARRAY_BUFFER, 0);
+
+	for (i = 0; i < (colors ? 5 : 4); i++) {
+		attrib = __GTKGLUT_INSTANCE_ATTRIB + i;
+
+		funcs->vertex_attrib_pointer(attrib, 4, GL_FLOAT, GL_FALSE,
+					     (i < 4 ? 16 : 4) * sizeof(GLfloat),
+					     i < 4 ? matrices + 4 * i : colors);
+		funcs->vertex_attrib_divisor(attrib, 1);
+		funcs->enable_vertex_attrib_array(attrib);
+	}
+
+	funcs->draw_elements_instanced(mesh->mode, mesh->num_indices, GL_UNSIGNED_INT, indices,
+				       count);
+
+	for (i = 0; i < (colors ? 5 : 4); i++) {
+		attrib = __GTKGLUT_INSTANCE_ATTRIB + i;
+
+		funcs->vertex_attrib_divisor(attrib, 0);
+		funcs->disable_vertex_attrib_array(attrib);
+	}
+
+	funcs->use_program((GLuint) old_program);
+
+	return TRUE;
+}
+
+void __gtkglut_mesh_draw_instanced(int shape, GLfloat param, int slices, int stacks,
+				   gboolean solid, __gtkglut_mesh_generator generator,
+				   GLdouble sx, GLdouble sy, GLdouble sz, int count,
+				   const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_mesh_struct tmp_mesh;
+	__gtkglut_mesh_struct *mesh;
+	const GLuint *indices;
+	gboolean normalize;
+	int i;
+
+	if (count < 1 || !__gtkglut_context->current_gl_context)
+		return;
+
+	if (slices < 1 || stacks < 1
+	    || (gint64) (slices + 1) * (stacks + 1) > __GTKGLUT_MESH_MAX_VERTICES)
+		return;
+
+	mesh = __gtkglut_mesh_acquire(shape, param, slices, stacks, solid, generator, &tmp_mesh,
+				      TRUE);
+
+	indices = __gtkglut_mesh_bind(mesh);
+
+	if (!__gtkglut_mesh_draw_instanced_arb(mesh, indices, sx, sy, sz, count, matrices,
+					       colors)) {
+		/*
+		 * Instance matrices may scale too
+		 */
+		normalize = !glIsEnabled(GL_NORMALIZE);
+
+		if (normalize)
+			glEnable(GL_NORMALIZE);
+
+		if (colors)
+			glPushAttrib(GL_CURRENT_BIT);
+
+		for (i = 0; i < count; i++) {
+			glPushMatrix();
+			glMultMatrixf(matrices + 16 * i);
+			glScaled(sx, sy, sz);
+
+			if (colors)
+				glColor4fv(colors + 4 * i);
+
+			glDrawElements(mesh->mode, mesh->num_indices, GL_UNSIGNED_INT, indices);
+			glPopMatrix();
+		}
+
+		if (colors)
+			glPopAttrib();
+
+		if (normalize)
+			glDisable(GL_NORMALIZE);
+	}
+
+	__gtkglut_mesh_unbind();
+
+	__gtkglut_mesh_release(mesh, &tmp_mesh);
+}
+
+/*
+ * Drop meshes and instancing program of GL context. Buffers and program are
+ * deleted only if gl_context is current (in_context).
+ */
+void __gtkglut_mesh_cache_purge(GdkGLContext * gl_context, gboolean in_context)
+{
+	__gtkglut_instanced_program_struct *program;
+	__gtkglut_mesh_struct *mesh;
+	__gtkglut_mesh_struct *next;
+
+	for (mesh = __gtkglut_context->mesh_lru_first; mesh; mesh = next) {
+		next = mesh->next;
+
+		if (mesh->key.gl_context == gl_context)
+			__gtkglut_mesh_free(mesh, in_context);
+	}
+
+	program = NULL;
+
+	if (__gtkglut_context->instanced_programs) {
+		program = (__gtkglut_instanced_program_struct *)
+		    g_hash_table_lookup(__gtkglut_context->instanced_programs, gl_context);
+	}
+
+	if (program) {
+		if (in_context)
+			__gtkglut_context->instancing_funcs.delete_program(program->program);
+
+		g_hash_table_remove(__gtkglut_context->instanced_programs, gl_context);
+		free(program);
+	}
+}
@@ -38,6 +38,21 @@
 #include "gtkglut_internal.h"
 #include <math.h>
 
+static void __gtkglut_mesh_sphere(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_cone(__gtkglut_mesh_data_struct * data, GLfloat param,
+				int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_torus(__gtkglut_mesh_data_struct * data, GLfloat param,
+				 int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_cylinder(__gtkglut_mesh_data_struct * data, GLfloat param,
+				    int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_cube(__gtkglut_mesh_data_struct * data, GLfloat param,
+				int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_sponge(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid);
+static void __gtkglut_mesh_teapot(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid);
+
 /*!
  * \defgroup geometry Geometric Rendering
  *
@@ -72,6 +87,10 @@ void glutSolidSphere(GLdouble radius, GLint slices, GLint stacks)
 
 	__gtkglut_test_inicialization("glutSolidSphere");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_SPHERE, 0.0, slices, stacks, TRUE,
+				__gtkglut_mesh_sphere, radius, radius, radius))
+		return;
+
 	gdk_gl_draw_sphere(TRUE, radius, slices, stacks);
 }
 
@@ -98,6 +117,10 @@ void glutWireSphere(GLdouble radius, GLint slices, GLint stacks)
 
 	__gtkglut_test_inicialization("glutWireSphere");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_SPHERE, 0.0, slices, stacks, FALSE,
+				__gtkglut_mesh_sphere, radius, radius, radius))
+		return;
+
 	gdk_gl_draw_sphere(FALSE, radius, slices, stacks);
 }
 
@@ -119,6 +142,10 @@ void glutSolidCube(GLdouble size)
 
 	__gtkglut_test_inicialization("glutSolidCube");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CUBE, 0.0, 1, 1, TRUE, __gtkglut_mesh_cube,
+				size, size, size))
+		return;
+
 	gdk_gl_draw_cube(TRUE, size);
 }
 
@@ -139,6 +166,10 @@ void glutWireCube(GLdouble size)
 {
 	__gtkglut_test_inicialization("glutWireCube");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CUBE, 0.0, 1, 1, FALSE, __gtkglut_mesh_cube,
+				size, size, size))
+		return;
+
 	gdk_gl_draw_cube(FALSE, size);
 }
 
@@ -164,6 +195,10 @@ void glutSolidCone(GLdouble base, GLdouble height, GLint slices, GLint stacks)
 
 	__gtkglut_test_inicialization("glutSolidCone");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CONE, 0.0, slices, stacks, TRUE,
+				__gtkglut_mesh_cone, base, base, height))
+		return;
+
 	gdk_gl_draw_cone(TRUE, base, height, slices, stacks);
 }
 
@@ -188,6 +223,10 @@ void glutWireCone(GLdouble base, GLdouble height, GLint slices, GLint stacks)
 
 	__gtkglut_test_inicialization("glutWireCone");
 
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CONE, 0.0, slices, stacks, FALSE,
+				__gtkglut_mesh_cone, base, base, height))
+		return;
+
 	gdk_gl_draw_cone(FALSE, base, height, slices, stacks);
 }
 
@@ -218,6 +257,15 @@ void glutSolidTorus(GLdouble innerRadius, GLdouble outerRadius, GLint nsides, GL
 
 	__gtkglut_test_inicialization("glutSolidTorus");
 
+	/*
+	 * Shape of torus depends only on ratio of radii
+	 */
+	if (outerRadius != 0.0
+	    && __gtkglut_mesh_draw(__GTKGLUT_MESH_TORUS, innerRadius / outerRadius, nsides, rings,
+				   TRUE, __gtkglut_mesh_torus, outerRadius, outerRadius,
+				   outerRadius))
+		return;
+
 	gdk_gl_draw_torus(TRUE, innerRadius, outerRadius, nsides, rings);
 }
 
@@ -247,6 +295,12 @@ void glutWireTorus(GLdouble innerRadius, GLdouble outerRadius, GLint nsides, GLi
 {
 	__gtkglut_test_inicialization("glutWireTorus");
 
+	if (outerRadius != 0.0
+	    && __gtkglut_mesh_draw(__GTKGLUT_MESH_TORUS, innerRadius / outerRadius, nsides, rings,
+				   FALSE, __gtkglut_mesh_torus, outerRadius, outerRadius,
+				   outerRadius))
+		return;
+
 	gdk_gl_draw_torus(FALSE, innerRadius, outerRadius, nsides, rings);
 }
 
@@ -430,12 +484,29 @@ void glutWireIcosahedron(void)
 	gdk_gl_draw_icosahedron(FALSE);
 }
 
+/*
+ * Draw teapot from mesh cache. Mesh has no texture coordinates, so textured teapot
+ * is left to evaluators. Returns FALSE, if teapot was not drawn.
+ */
+static gboolean __gtkglut_teapot_draw(GLdouble size, gboolean solid)
+{
+	int grid;
+
+	if (!__gtkglut_context->current_gl_context || glIsEnabled(GL_TEXTURE_2D))
+		return FALSE;
+
+	grid = __gtkglut_context->teapot_grid;
+
+	return __gtkglut_mesh_draw(__GTKGLUT_MESH_TEAPOT, 0.0, grid, grid, solid,
+				   __gtkglut_mesh_teapot, size, size, size);
+}
+
 /*!
  * \brief    Draw a solid teapot.
  * \ingroup  geometry
  * \param    size        Scale factor.
  *
- * Draws the standard Teapot, solid shaded, using OpenGL evaluators.
+ * Draws the standard Teapot, solid shaded.
  * This is the classic "Utah Teapot" of computer graphics.
  * The base should lie in the xy-plane with "up" being
  * along the positive z axis.
@@ -444,6 +515,12 @@ void glutWireIcosahedron(void)
  * be the same as the teapot modeled by Martin Newell
  * in 1975.
  *
+ * \note Bezier patches of teapot are tessellated on CPU into triangle mesh
+ *       with resolution \a GTKGLUT_TEAPOT_GRID (see glutSetOption()), which
+ *       is kept in mesh cache.  OpenGL evaluators are used only with disabled
+ *       mesh cache or enabled GL_TEXTURE_2D, because mesh has no texture
+ *       coordinates.
+ *
  * \see glutWireTeapot()
 */
 void glutSolidTeapot(GLdouble size)
@@ -451,6 +528,9 @@ void glutSolidTeapot(GLdouble size)
 
 	__gtkglut_test_inicialization("glutSolidTeapot");
 
+	if (__gtkglut_teapot_draw(size, TRUE))
+		return;
+
 	gdk_gl_draw_teapot(TRUE, size);
 }
 
@@ -459,8 +539,7 @@ void glutSolidTeapot(GLdouble size)
  * \ingroup  geometry
  * \param    size        Scale factor.
  *
- * This function draws the standard Teapot in wireframe
- * using OpenGL evaluators.
+ * This function draws the standard Teapot in wireframe.
  * This is the classic "Utah Teapot" of computer graphics.
  * The base should lie in the xy-plane with "up" being
  * along the positive z axis.
@@ -469,6 +548,9 @@ void glutSolidTeapot(GLdouble size)
  * be the same as the teapot modeled by Martin Newell
  * in 1975.
  *
+ * \note Wireframe is made of lines of tessellation grid, same as
+ *       glutSolidTeapot() uses.
+ *
  * \see glutSolidTeapot()
  */
 void glutWireTeapot(GLdouble size)
@@ -476,6 +558,9 @@ void glutWireTeapot(GLdouble size)
 
 	__gtkglut_test_inicialization("glutWireTeapot");
 
+	if (__gtkglut_teapot_draw(size, FALSE))
+		return;
+
 	gdk_gl_draw_teapot(FALSE, size);
 }
 
@@ -601,6 +686,42 @@ static GLint __gtkglut_tet_i[4][3] = {
 	{1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2}
 };
 
+/*
+ * Deepest sponge, which is drawn from mesh cache (12 * 4^7 vertices, about
+ * 6 MB, so it fits under default cache size), and depth from which sponge
+ * mesh is generated in parallel
+ */
+#define __GTKGLUT_SPONGE_MAX_LEVELS      7
+#define __GTKGLUT_SPONGE_PARALLEL_LEVELS 5
+
+/*
+ * Draw sponge from mesh cache, offset and scale are applied by matrix stack.
+ * Returns FALSE, if sponge must be drawn by recursion.
+ */
+static gboolean __gtkglut_sponge_draw(int num_levels, GLdouble offset[3], GLdouble scale,
+				      gboolean solid)
+{
+	gboolean res;
+
+	/*
+	 * Sponge key is (num_levels + 1, 1), so vertex limit of __gtkglut_mesh_draw
+	 * doesn't apply. Mesh which doesn't fit into cache (with meshes of other
+	 * contexts) is not generated, sponge is drawn by recursion then.
+	 */
+	if (num_levels < 0 || num_levels > __GTKGLUT_SPONGE_MAX_LEVELS)
+		return FALSE;
+
+	glPushMatrix();
+	glTranslated(offset[0], offset[1], offset[2]);
+
+	res = __gtkglut_mesh_draw(__GTKGLUT_MESH_SPONGE, 0.0, num_levels + 1, 1, solid,
+				  __gtkglut_mesh_sponge, scale, scale, scale);
+
+	glPopMatrix();
+
+	return res;
+}
+
 /*!
  * \brief    Draw a wireframe Spierspinski's sponge.
  * \ingroup  geometry
@@ -616,7 +737,10 @@ static GLint __gtkglut_tet_i[4][3] = {
  * The \a z axis is normal to the base.
  * The sponge is centered at the origin.
  *
- * \note Runtime is exponential in \a num_levels .
+ * \note Sponge with up to 7 levels is generated once into mesh cache
+ *       (see \a GTKGLUT_MESH_CACHE_SIZE in glutSetOption()) and drawn
+ *       by one call, if it fits under cache size.  Otherwise runtime is
+ *       exponential in \a num_levels .
  *
  * \see glutSolidSierpinskiSponge()
  */
@@ -626,6 +750,9 @@ void glutWireSierpinskiSponge(int num_levels, GLdouble offset[3], GLdouble scale
 
 	__gtkglut_test_inicialization("glutWireSierpinskiSponge");
 
+	if (__gtkglut_sponge_draw(num_levels, offset, scale, FALSE))
+		return;
+
 	if (num_levels == 0) {
 
 		for (i = 0; i < __GTKGLUT_NUM_TETR_FACES; i++) {
@@ -674,7 +801,10 @@ void glutWireSierpinskiSponge(int num_levels, GLdouble offset[3], GLdouble scale
  * The \a z axis is normal to the base.
  * The sponge is centered at the origin.
  *
- * \note Runtime is exponential in \a num_levels .
+ * \note Sponge with up to 7 levels is generated once into mesh cache
+ *       (see \a GTKGLUT_MESH_CACHE_SIZE in glutSetOption()) and drawn
+ *       by one call, if it fits under cache size.  Otherwise runtime is
+ *       exponential in \a num_levels .
  *
  * \todo Consider removing the \a offset parameter from the
  *       API (use a helper function).
@@ -687,6 +817,9 @@ void glutSolidSierpinskiSponge(int num_levels, GLdouble offset[3], GLdouble scal
 
 	__gtkglut_test_inicialization("glutSolidSierpinskiSponge");
 
+	if (__gtkglut_sponge_draw(num_levels, offset, scale, TRUE))
+		return;
+
 	if (num_levels == 0) {
 		glBegin(GL_TRIANGLES);
 
@@ -722,16 +855,30 @@ void glutSolidSierpinskiSponge(int num_levels, GLdouble offset[3], GLdouble scal
 }
 
 /*
- * Compute lookup table of cos and sin values forming a cirle
+ * Maximum number of samples of circle table, which is cached. Tables with more
+ * samples are computed for every call, so arbitrary slices and stacks values
+ * can't make the cache grow without bound.
+ */
+#define __GTKGLUT_CIRCLE_TABLE_CACHE_MAX 1024
+
+/*
+ * Return lookup table of cos and sin values forming a cirle
  *
  * Notes:
- *    It is the responsibility of the caller to free these tables
+ *    Tables of at most __GTKGLUT_CIRCLE_TABLE_CACHE_MAX samples are cached for
+ *    whole process, larger ones are temporary. Returned table must be passed
+ *    to __gtkglut_circle_table_free when it's no longer needed
  *    The size of the table is (n+1) to form a connected loop
  *    The last entry is exactly the same as the first
  *    The sign of n can be flipped to get the reverse loop
+ *    Arrays are 16 bytes aligned and padded to multiple of 4 floats
+ *    (padding repeats first entry), so they can be processed by SIMD
  */
-static void __gtkglut_circle_table(double **sint, double **cost, const int n)
+static __gtkglut_circle_table_struct *__gtkglut_circle_table(const GLfloat **sint,
+							     const GLfloat **cost, const int n)
 {
+	__gtkglut_circle_table_struct *table;
+	int padded_size;
 	int i;
 
 	/*
@@ -746,41 +893,825 @@ static void __gtkglut_circle_table(double **sint, double **cost, const int n)
 
 	const double angle = 2 * __GTKGLUT_M_PI / (double)((n == 0) ? 1 : n);
 
-	/*
-	 * Allocate memory for n samples, plus duplicate of first entry at the end
-	 */
+	if (size <= __GTKGLUT_CIRCLE_TABLE_CACHE_MAX) {
+		if (!__gtkglut_context->circle_tables)
+			__gtkglut_context->circle_tables = g_hash_table_new(NULL, NULL);
+
+		table = (__gtkglut_circle_table_struct *)
+		    g_hash_table_lookup(__gtkglut_context->circle_tables, GINT_TO_POINTER(n));
 
-	*sint = (double *)calloc(sizeof(double), size + 1);
-	*cost = (double *)calloc(sizeof(double), size + 1);
+		if (table) {
+			*sint = table->sint;
+			*cost = table->cost;
+
+			return table;
+		}
+	}
 
 	/*
-	 * Bail out if memory allocation fails, fgError never returns
+	 * Allocate memory for n samples, plus duplicate of first entry at the end,
+	 * both arrays in one block
 	 */
 
-	if (!(*sint) || !(*cost)) {
-		free(*sint);
-		free(*cost);
+	padded_size = (size + 1 + 3) & ~3;
+
+	table = (__gtkglut_circle_table_struct *) malloc(sizeof(__gtkglut_circle_table_struct));
+
+	if (table)
+		table->memory = malloc(2 * padded_size * sizeof(GLfloat) + 15);
+
+	if (!table || !table->memory) {
+		free(table);
 		__gtkglut_lowmem();
 	}
 
+	table->sint = (GLfloat *) (((gsize) table->memory + 15) & ~(gsize) 15);
+	table->cost = table->sint + padded_size;
+
 	/*
 	 * Compute cos and sin around the circle
 	 */
 
-	(*sint)[0] = 0.0;
-	(*cost)[0] = 1.0;
+	table->sint[0] = 0.0;
+	table->cost[0] = 1.0;
 
 	for (i = 1; i < size; i++) {
-		(*sint)[i] = sin(angle * i);
-		(*cost)[i] = cos(angle * i);
+		table->sint[i] = (GLfloat) sin(angle * i);
+		table->cost[i] = (GLfloat) cos(angle * i);
+	}
+
+	/*
+	 * Last sample and padding are duplicates of the first
+	 */
+
+	for (i = MAX(size, 1); i < padded_size; i++) {
+		table->sint[i] = table->sint[0];
+		table->cost[i] = table->cost[0];
+	}
+
+	table->cached = (size <= __GTKGLUT_CIRCLE_TABLE_CACHE_MAX);
+
+	if (table->cached)
+		g_hash_table_insert(__gtkglut_context->circle_tables, GINT_TO_POINTER(n), table);
+
+	*sint = table->sint;
+	*cost = table->cost;
+
+	return table;
+}
+
+/*
+ * Free table returned by __gtkglut_circle_table, if it is not cached
+ */
+static void __gtkglut_circle_table_free(__gtkglut_circle_table_struct * table)
+{
+	if (table->cached)
+		return;
+
+	free(table->memory);
+	free(table);
+}
+
+/*
+ * Allocate mesh data for at most num_vertices vertices and num_indices indices.
+ * If data are only measured, capacity is stored and FALSE is returned, so
+ * generator must return.
+ */
+static gboolean __gtkglut_mesh_data_alloc(__gtkglut_mesh_data_struct * data, GLenum mode,
+					  int num_vertices, int num_indices)
+{
+	if (data->measure) {
+		data->num_vertices = num_vertices;
+		data->num_indices = num_indices;
+
+		return FALSE;
+	}
+
+	data->vertices = (GLfloat *) malloc(num_vertices * 6 * sizeof(GLfloat));
+	data->indices = (GLuint *) malloc(num_indices * sizeof(GLuint));
+
+	if (!data->vertices || !data->indices) {
+		free(data->vertices);
+		free(data->indices);
+		__gtkglut_lowmem();
+	}
+
+	data->num_vertices = 0;
+	data->num_indices = 0;
+	data->mode = mode;
+
+	return TRUE;
+}
+
+/*
+ * Append vertex with normal (nx, ny, nz) and position (x, y, z)
+ */
+static void __gtkglut_mesh_data_vertex(__gtkglut_mesh_data_struct * data, double nx, double ny,
+				       double nz, double x, double y, double z)
+{
+	GLfloat *v;
+
+	v = data->vertices + data->num_vertices * 6;
+
+	v[0] = (GLfloat) nx;
+	v[1] = (GLfloat) ny;
+	v[2] = (GLfloat) nz;
+	v[3] = (GLfloat) x;
+	v[4] = (GLfloat) y;
+	v[5] = (GLfloat) z;
+
+	data->num_vertices++;
+}
+
+static void __gtkglut_mesh_data_line(__gtkglut_mesh_data_struct * data, GLuint a, GLuint b)
+{
+	data->indices[data->num_indices++] = a;
+	data->indices[data->num_indices++] = b;
+}
+
+static void __gtkglut_mesh_data_triangle(__gtkglut_mesh_data_struct * data, GLuint a, GLuint b,
+					 GLuint c)
+{
+	data->indices[data->num_indices++] = a;
+	data->indices[data->num_indices++] = b;
+	data->indices[data->num_indices++] = c;
+}
+
+/*
+ * Append surface of revolution around z axis. Ring i (0 - rings, from bottom
+ * to top) has radius radius[i], height z[i] and normal (nr[i] * x, nr[i] * y, nz[i]),
+ * where (x, y) = (xt[j], yt[j]), j = 0 - slices, is point of circle table.
+ * Rings with zero radius (poles, apex) don't produce degenerated triangles.
+ * Data must have space for (rings + 1) * (slices + 1) vertices and
+ * rings * slices * 6 (solid) or (rings + 1) * slices * 4 (wire) indices.
+ */
+static void __gtkglut_mesh_data_revolution(__gtkglut_mesh_data_struct * data,
+					   const GLfloat * xt, const GLfloat * yt, int slices,
+					   const double *radius, const double *z, const double *nr,
+					   const double *nz, int rings, gboolean solid)
+{
+	GLuint first, l0, l1, u0, u1;
+	int i, j;
+
+	first = data->num_vertices;
+
+	for (i = 0; i <= rings; i++) {
+		for (j = 0; j <= slices; j++) {
+			__gtkglut_mesh_data_vertex(data, nr[i] * xt[j], nr[i] * yt[j], nz[i],
+						   radius[i] * xt[j], radius[i] * yt[j], z[i]);
+		}
+	}
+
+	for (i = 0; i <= rings; i++) {
+		for (j = 0; j < slices; j++) {
+			l0 = first + i * (slices + 1) + j;
+			l1 = l0 + 1;
+			u0 = l0 + slices + 1;
+			u1 = u0 + 1;
+
+			if (solid) {
+				if (i == rings)
+					continue;
+
+				if (radius[i + 1] != 0.0)
+					__gtkglut_mesh_data_triangle(data, l0, u0, u1);
+				if (radius[i] != 0.0)
+					__gtkglut_mesh_data_triangle(data, l0, u1, l1);
+			} else {
+				if (i < rings)
+					__gtkglut_mesh_data_line(data, l0, u0);
+				if (radius[i] != 0.0)
+					__gtkglut_mesh_data_line(data, l0, l1);
+			}
+		}
+	}
+}
+
+/*
+ * Allocate ring arrays for __gtkglut_mesh_data_revolution
+ */
+static double *__gtkglut_mesh_rings_alloc(int rings, double **radius, double **z, double **nr,
+					  double **nz)
+{
+	double *res;
+
+	res = (double *)malloc(4 * (rings + 1) * sizeof(double));
+
+	if (!res)
+		__gtkglut_lowmem();
+
+	*radius = res;
+	*z = res + (rings + 1);
+	*nr = res + 2 * (rings + 1);
+	*nz = res + 3 * (rings + 1);
+
+	return res;
+}
+
+/*
+ * Unit sphere with poles on z axis (same orientation as gluSphere)
+ */
+static void __gtkglut_mesh_sphere(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid)
+{
+	__gtkglut_circle_table_struct *table1, *table2;
+	const GLfloat *sint1, *cost1, *sint2, *cost2;
+	double *rings, *radius, *z, *nr, *nz;
+	int i;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       (stacks + 1) * (slices + 1),
+				       solid ? stacks * slices * 6 : (stacks + 1) * slices * 4))
+		return;
+
+	table1 = __gtkglut_circle_table(&sint1, &cost1, slices);
+	table2 = __gtkglut_circle_table(&sint2, &cost2, 2 * stacks);
+
+	rings = __gtkglut_mesh_rings_alloc(stacks, &radius, &z, &nr, &nz);
+
+	for (i = 0; i <= stacks; i++) {
+		radius[i] = nr[i] = (i == 0 || i == stacks) ? 0.0 : sint2[i];
+		z[i] = nz[i] = -cost2[i];
+	}
+
+	__gtkglut_mesh_data_revolution(data, sint1, cost1, slices, radius, z, nr, nz, stacks,
+				       solid);
+
+	free(rings);
+	__gtkglut_circle_table_free(table1);
+	__gtkglut_circle_table_free(table2);
+}
+
+/*
+ * Cone with unit base radius and height, without base (same as gluCylinder
+ * with zero top radius)
+ */
+static void __gtkglut_mesh_cone(__gtkglut_mesh_data_struct * data, GLfloat param,
+				int slices, int stacks, gboolean solid)
+{
+	__gtkglut_circle_table_struct *table;
+	const GLfloat *sint, *cost;
+	double *rings, *radius, *z, *nr, *nz;
+	int i;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       (stacks + 1) * (slices + 1),
+				       solid ? stacks * slices * 6 : (stacks + 1) * slices * 4))
+		return;
+
+	table = __gtkglut_circle_table(&sint, &cost, slices);
+
+	rings = __gtkglut_mesh_rings_alloc(stacks, &radius, &z, &nr, &nz);
+
+	for (i = 0; i <= stacks; i++) {
+		z[i] = (double)i / stacks;
+		radius[i] = (i == stacks) ? 0.0 : 1.0 - z[i];
+		nr[i] = nz[i] = sqrt(0.5);
+	}
+
+	__gtkglut_mesh_data_revolution(data, sint, cost, slices, radius, z, nr, nz, stacks, solid);
+
+	free(rings);
+	__gtkglut_circle_table_free(table);
+}
+
+/*
+ * Torus with unit outer radius and inner radius param. Slices are sides
+ * of tube, stacks are rings along path.
+ */
+static void __gtkglut_mesh_torus(__gtkglut_mesh_data_struct * data, GLfloat param,
+				 int slices, int stacks, gboolean solid)
+{
+	__gtkglut_circle_table_struct *table1, *table2;
+	const GLfloat *sint1, *cost1, *sint2, *cost2;
+	double dist;
+	GLuint v;
+	int i, j;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       (stacks + 1) * (slices + 1),
+				       stacks * slices * (solid ? 6 : 4)))
+		return;
+
+	table1 = __gtkglut_circle_table(&sint1, &cost1, slices);
+	table2 = __gtkglut_circle_table(&sint2, &cost2, stacks);
+
+	for (i = 0; i <= stacks; i++) {
+		for (j = 0; j <= slices; j++) {
+			dist = 1.0 + param * cost1[j];
+
+			__gtkglut_mesh_data_vertex(data, cost1[j] * cost2[i], cost1[j] * sint2[i],
+						   sint1[j], dist * cost2[i], dist * sint2[i],
+						   param * sint1[j]);
+		}
+	}
+
+	for (i = 0; i < stacks; i++) {
+		for (j = 0; j < slices; j++) {
+			v = i * (slices + 1) + j;
+
+			if (solid) {
+				__gtkglut_mesh_data_triangle(data, v, v + slices + 1,
+							     v + slices + 2);
+				__gtkglut_mesh_data_triangle(data, v, v + slices + 2, v + 1);
+			} else {
+				__gtkglut_mesh_data_line(data, v, v + slices + 1);
+				__gtkglut_mesh_data_line(data, v, v + 1);
+			}
+		}
+	}
+
+	__gtkglut_circle_table_free(table1);
+	__gtkglut_circle_table_free(table2);
+}
+
+/*
+ * Cylinder with unit radius and height. Solid cylinder has base and top.
+ */
+static void __gtkglut_mesh_cylinder(__gtkglut_mesh_data_struct * data, GLfloat param,
+				    int slices, int stacks, gboolean solid)
+{
+	__gtkglut_circle_table_struct *table;
+	const GLfloat *sint, *cost;
+	double *rings, *radius, *z, *nr, *nz;
+	GLuint center;
+	int i, j;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       (stacks + 1) * (slices + 1) + 2 * (slices + 2),
+				       solid ? (stacks + 2) * slices * 6 :
+				       (stacks + 1) * slices * 4))
+		return;
+
+	table = __gtkglut_circle_table(&sint, &cost, -slices);
+
+	rings = __gtkglut_mesh_rings_alloc(stacks, &radius, &z, &nr, &nz);
+
+	for (i = 0; i <= stacks; i++) {
+		radius[i] = nr[i] = 1.0;
+		z[i] = (double)i / stacks;
+		nz[i] = 0.0;
+	}
+
+	__gtkglut_mesh_data_revolution(data, cost, sint, slices, radius, z, nr, nz, stacks, solid);
+
+	if (solid) {
+		/*
+		 * Cover the base and top
+		 */
+		center = data->num_vertices;
+
+		__gtkglut_mesh_data_vertex(data, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0);
+		for (j = 0; j <= slices; j++)
+			__gtkglut_mesh_data_vertex(data, 0.0, 0.0, -1.0, cost[j], sint[j], 0.0);
+
+		for (j = 0; j < slices; j++)
+			__gtkglut_mesh_data_triangle(data, center, center + j + 1, center + j + 2);
+
+		center = data->num_vertices;
+
+		__gtkglut_mesh_data_vertex(data, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0);
+		for (j = 0; j <= slices; j++)
+			__gtkglut_mesh_data_vertex(data, 0.0, 0.0, 1.0, cost[j], sint[j], 1.0);
+
+		for (j = 0; j < slices; j++)
+			__gtkglut_mesh_data_triangle(data, center, center + j + 2, center + j + 1);
+	}
+
+	free(rings);
+	__gtkglut_circle_table_free(table);
+}
+
+/*
+ * Faces of cube as normal and two axes of face, which form right-handed system
+ */
+static const GLfloat __gtkglut_cube_faces[6][9] = {
+	{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0},
+	{-1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0},
+	{0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0},
+	{0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0},
+	{0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0},
+	{0.0, 0.0, -1.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0}
+};
+
+/*
+ * Cube with unit side centered at origin. Wire cube draws outline of every face.
+ */
+static void __gtkglut_mesh_cube(__gtkglut_mesh_data_struct * data, GLfloat param,
+				int slices, int stacks, gboolean solid)
+{
+	static const double corners[4][2] = { {-0.5, -0.5}, {0.5, -0.5}, {0.5, 0.5}, {-0.5, 0.5} };
+	const GLfloat *f;
+	GLuint v;
+	int i, j, k;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES, 24, solid ? 36 : 48))
+		return;
+
+	for (i = 0; i < 6; i++) {
+		f = __gtkglut_cube_faces[i];
+		v = data->num_vertices;
+
+		for (j = 0; j < 4; j++) {
+			__gtkglut_mesh_data_vertex(data, f[0], f[1], f[2],
+						   0.5 * f[0] + corners[j][0] * f[3] +
+						   corners[j][1] * f[6],
+						   0.5 * f[1] + corners[j][0] * f[4] +
+						   corners[j][1] * f[7],
+						   0.5 * f[2] + corners[j][0] * f[5] +
+						   corners[j][1] * f[8]);
+		}
+
+		if (solid) {
+			__gtkglut_mesh_data_triangle(data, v, v + 1, v + 2);
+			__gtkglut_mesh_data_triangle(data, v, v + 2, v + 3);
+		} else {
+			for (k = 0; k < 4; k++)
+				__gtkglut_mesh_data_line(data, v + k, v + (k + 1) % 4);
+		}
+	}
+}
+
+/*
+ * Part of sponge mesh generated by one thread
+ */
+typedef struct __gtkglut_sponge_job_struct {
+	__gtkglut_mesh_data_struct *data;
+	int num_levels;
+	gboolean solid;
+	int first;
+	int count;
+} __gtkglut_sponge_job_struct;
+
+/*
+ * Generate tetrahedra first - first + count - 1 of sponge with offset 0 and
+ * scale 1. Position of tetrahedron is given by its base 4 digits (most
+ * significant digit is top level subtree), so every tetrahedron is computed
+ * independently and is written to its own part of arrays.
+ */
+static gpointer __gtkglut_sponge_fill(gpointer job_ptr)
+{
+	__gtkglut_sponge_job_struct *job;
+	GLfloat *v;
+	GLuint *index;
+	GLuint first_vertex;
+	const GLdouble *r;
+	double offset[3];
+	double scale;
+	int t, i, j, k, digit;
+
+	job = (__gtkglut_sponge_job_struct *) job_ptr;
+
+	for (t = job->first; t < job->first + job->count; t++) {
+		offset[0] = offset[1] = offset[2] = 0.0;
+		scale = 1.0;
+
+		for (k = job->num_levels - 1; k >= 0; k--) {
+			digit = (t >> (2 * k)) & 3;
+			scale /= 2.0;
+
+			offset[0] += scale * __gtkglut_tet_r[digit][0];
+			offset[1] += scale * __gtkglut_tet_r[digit][1];
+			offset[2] += scale * __gtkglut_tet_r[digit][2];
+		}
+
+		first_vertex = t * __GTKGLUT_NUM_TETR_FACES * 3;
+		v = job->data->vertices + first_vertex * 6;
+
+		for (i = 0; i < __GTKGLUT_NUM_TETR_FACES; i++) {
+			for (j = 0; j < 3; j++) {
+				r = __gtkglut_tet_r[__gtkglut_tet_i[i][j]];
+
+				*v++ = (GLfloat) - __gtkglut_tet_r[i][0];
+				*v++ = (GLfloat) - __gtkglut_tet_r[i][1];
+				*v++ = (GLfloat) - __gtkglut_tet_r[i][2];
+				*v++ = (GLfloat) (offset[0] + scale * r[0]);
+				*v++ = (GLfloat) (offset[1] + scale * r[1]);
+				*v++ = (GLfloat) (offset[2] + scale * r[2]);
+			}
+		}
+
+		if (job->solid) {
+			index = job->data->indices + first_vertex;
+
+			for (i = 0; i < __GTKGLUT_NUM_TETR_FACES * 3; i++)
+				index[i] = first_vertex + i;
+		} else {
+			/*
+			 * Outline of every face
+			 */
+			index = job->data->indices + first_vertex * 2;
+
+			for (i = 0; i < __GTKGLUT_NUM_TETR_FACES; i++) {
+				for (j = 0; j < 3; j++) {
+					*index++ = first_vertex + i * 3 + j;
+					*index++ = first_vertex + i * 3 + (j + 1) % 3;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Sponge with num_levels (slices - 1) levels, offset 0 and scale 1. Four top
+ * level subtrees of deep sponge are generated in parallel.
+ */
+static void __gtkglut_mesh_sponge(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid)
+{
+	__gtkglut_sponge_job_struct jobs[4];
+	GThread *threads[4];
+	int num_levels;
+	int num_tetr;
+	int num_jobs;
+	int i;
+
+	num_levels = slices - 1;
+	num_tetr = 1 << (2 * num_levels);
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       num_tetr * __GTKGLUT_NUM_TETR_FACES * 3,
+				       num_tetr * __GTKGLUT_NUM_TETR_FACES * (solid ? 3 : 6)))
+		return;
+
+	num_jobs = (num_levels >= __GTKGLUT_SPONGE_PARALLEL_LEVELS) ? 4 : 1;
+
+	for (i = 0; i < num_jobs; i++) {
+		jobs[i].data = data;
+		jobs[i].num_levels = num_levels;
+		jobs[i].solid = solid;
+		jobs[i].count = num_tetr / num_jobs;
+		jobs[i].first = i * jobs[i].count;
 	}
 
 	/*
-	 * Last sample is duplicate of the first
+	 * First subtree is generated by this thread. If thread can't be created,
+	 * its subtree is generated here too.
 	 */
+	for (i = 1; i < num_jobs; i++) {
+#if GLIB_CHECK_VERSION(2, 34, 0)
+		threads[i] = g_thread_try_new("gtkglut-sponge", __gtkglut_sponge_fill, &jobs[i],
+					      NULL);
+#else
+		threads[i] = g_thread_supported() ?
+		    g_thread_create(__gtkglut_sponge_fill, &jobs[i], TRUE, NULL) : NULL;
+#endif
+	}
+
+	__gtkglut_sponge_fill(&jobs[0]);
+
+	for (i = 1; i < num_jobs; i++) {
+		if (threads[i])
+			g_thread_join(threads[i]);
+		else
+			__gtkglut_sponge_fill(&jobs[i]);
+	}
+
+	data->num_vertices = num_tetr * __GTKGLUT_NUM_TETR_FACES * 3;
+	data->num_indices = num_tetr * __GTKGLUT_NUM_TETR_FACES * (solid ? 3 : 6);
+}
+
+/*
+ * Newell teapot, same data as in GLUT and GdkGLExt. First six patches (rim, body,
+ * lid and bottom) are mirrored into all four quadrants, handle and spout only
+ * across xz plane.
+ */
+#define __GTKGLUT_TEAPOT_PATCHES      10
+#define __GTKGLUT_TEAPOT_FULL_PATCHES 6
+
+static const int __gtkglut_teapot_patches[__GTKGLUT_TEAPOT_PATCHES][16] = {
+	/* rim */
+	{102, 103, 104, 105, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+	/* body */
+	{12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27},
+	{24, 25, 26, 27, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40},
+	/* lid */
+	{96, 96, 96, 96, 97, 98, 99, 100, 101, 101, 101, 101, 0, 1, 2, 3},
+	{0, 1, 2, 3, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117},
+	/* bottom */
+	{118, 118, 118, 118, 124, 122, 119, 121, 123, 126, 125, 120, 40, 39, 38, 37},
+	/* handle */
+	{41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56},
+	{53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 28, 65, 66, 67},
+	/* spout */
+	{68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83},
+	{80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95}
+};
+
+static const GLfloat __gtkglut_teapot_points[127][3] = {
+	{0.2, 0.0, 2.7}, {0.2, -0.112, 2.7}, {0.112, -0.2, 2.7}, {0.0, -0.2, 2.7},
+	{1.3375, 0.0, 2.53125}, {1.3375, -0.749, 2.53125}, {0.749, -1.3375, 2.53125},
+	{0.0, -1.3375, 2.53125}, {1.4375, 0.0, 2.53125}, {1.4375, -0.805, 2.53125},
+	{0.805, -1.4375, 2.53125}, {0.0, -1.4375, 2.53125}, {1.5, 0.0, 2.4},
+	{1.5, -0.84, 2.4}, {0.84, -1.5, 2.4}, {0.0, -1.5, 2.4}, {1.75, 0.0, 1.875},
+	{1.75, -0.98, 1.875}, {0.98, -1.75, 1.875}, {0.0, -1.75, 1.875}, {2.0, 0.0, 1.35},
+	{2.0, -1.12, 1.35}, {1.12, -2.0, 1.35}, {0.0, -2.0, 1.35}, {2.0, 0.0, 0.9},
+	{2.0, -1.12, 0.9}, {1.12, -2.0, 0.9}, {0.0, -2.0, 0.9}, {-2.0, 0.0, 0.9},
+	{2.0, 0.0, 0.45}, {2.0, -1.12, 0.45}, {1.12, -2.0, 0.45}, {0.0, -2.0, 0.45},
+	{1.5, 0.0, 0.225}, {1.5, -0.84, 0.225}, {0.84, -1.5, 0.225}, {0.0, -1.5, 0.225},
+	{1.5, 0.0, 0.15}, {1.5, -0.84, 0.15}, {0.84, -1.5, 0.15}, {0.0, -1.5, 0.15},
+	{-1.6, 0.0, 2.025}, {-1.6, -0.3, 2.025}, {-1.5, -0.3, 2.25}, {-1.5, 0.0, 2.25},
+	{-2.3, 0.0, 2.025}, {-2.3, -0.3, 2.025}, {-2.5, -0.3, 2.25}, {-2.5, 0.0, 2.25},
+	{-2.7, 0.0, 2.025}, {-2.7, -0.3, 2.025}, {-3.0, -0.3, 2.25}, {-3.0, 0.0, 2.25},
+	{-2.7, 0.0, 1.8}, {-2.7, -0.3, 1.8}, {-3.0, -0.3, 1.8}, {-3.0, 0.0, 1.8},
+	{-2.7, 0.0, 1.575}, {-2.7, -0.3, 1.575}, {-3.0, -0.3, 1.35}, {-3.0, 0.0, 1.35},
+	{-2.5, 0.0, 1.125}, {-2.5, -0.3, 1.125}, {-2.65, -0.3, 0.9375},
+	{-2.65, 0.0, 0.9375}, {-2.0, -0.3, 0.9}, {-1.9, -0.3, 0.6}, {-1.9, 0.0, 0.6},
+	{1.7, 0.0, 1.425}, {1.7, -0.66, 1.425}, {1.7, -0.66, 0.6}, {1.7, 0.0, 0.6},
+	{2.6, 0.0, 1.425}, {2.6, -0.66, 1.425}, {3.1, -0.66, 0.825}, {3.1, 0.0, 0.825},
+	{2.3, 0.0, 2.1}, {2.3, -0.25, 2.1}, {2.4, -0.25, 2.025}, {2.4, 0.0, 2.025},
+	{2.7, 0.0, 2.4}, {2.7, -0.25, 2.4}, {3.3, -0.25, 2.4}, {3.3, 0.0, 2.4},
+	{2.8, 0.0, 2.475}, {2.8, -0.25, 2.475}, {3.525, -0.25, 2.49375},
+	{3.525, 0.0, 2.49375}, {2.9, 0.0, 2.475}, {2.9, -0.15, 2.475},
+	{3.45, -0.15, 2.5125}, {3.45, 0.0, 2.5125}, {2.8, 0.0, 2.4}, {2.8, -0.15, 2.4},
+	{3.2, -0.15, 2.4}, {3.2, 0.0, 2.4}, {0.0, 0.0, 3.15}, {0.8, 0.0, 3.15},
+	{0.8, -0.45, 3.15}, {0.45, -0.8, 3.15}, {0.0, -0.8, 3.15}, {0.0, 0.0, 2.85},
+	{1.4, 0.0, 2.4}, {1.4, -0.784, 2.4}, {0.784, -1.4, 2.4}, {0.0, -1.4, 2.4},
+	{0.4, 0.0, 2.55}, {0.4, -0.224, 2.55}, {0.224, -0.4, 2.55}, {0.0, -0.4, 2.55},
+	{1.3, 0.0, 2.55}, {1.3, -0.728, 2.55}, {0.728, -1.3, 2.55}, {0.0, -1.3, 2.55},
+	{1.3, 0.0, 2.4}, {1.3, -0.728, 2.4}, {0.728, -1.3, 2.4}, {0.0, -1.3, 2.4},
+	{0.0, 0.0, 0.0}, {1.425, -0.798, 0.0}, {1.5, 0.0, 0.075}, {1.425, 0.0, 0.0},
+	{0.798, -1.425, 0.0}, {0.0, -1.5, 0.075}, {0.0, -1.425, 0.0},
+	{1.5, -0.84, 0.075}, {0.84, -1.5, 0.075}
+};
+
+/*
+ * Copies of patch as {reversed order of control points in row, sign of x, sign of y}
+ */
+static const int __gtkglut_teapot_copies[4][3] = {
+	{0, 1, 1}, {1, 1, -1}, {1, -1, 1}, {0, -1, -1}
+};
+
+/*
+ * Cubic Bernstein polynomials b and their derivatives d in t
+ */
+static void __gtkglut_bezier_basis(double t, double b[4], double d[4])
+{
+	double s;
+
+	s = 1.0 - t;
+
+	b[0] = s * s * s;
+	b[1] = 3.0 * t * s * s;
+	b[2] = 3.0 * t * t * s;
+	b[3] = t * t * t;
+
+	d[0] = -3.0 * s * s;
+	d[1] = 3.0 * s * s - 6.0 * t * s;
+	d[2] = 6.0 * t * s - 3.0 * t * t;
+	d[3] = 3.0 * t * t;
+}
+
+/*
+ * Evaluate point p of bicubic patch cp (rows in v) at u, v and its normal n as cross
+ * product of partial derivatives (same as GL_AUTO_NORMAL). Returns length of n.
+ */
+static double __gtkglut_bezier_eval(double cp[4][4][3], double u, double v, double p[3],
+				    double n[3])
+{
+	double bu[4], du[4], bv[4], dv[4];
+	double pu[3], pv[3];
+	int j, k, l;
+
+	__gtkglut_bezier_basis(u, bu, du);
+	__gtkglut_bezier_basis(v, bv, dv);
+
+	for (l = 0; l < 3; l++)
+		p[l] = pu[l] = pv[l] = 0.0;
+
+	for (j = 0; j < 4; j++) {
+		for (k = 0; k < 4; k++) {
+			for (l = 0; l < 3; l++) {
+				p[l] += bv[j] * bu[k] * cp[j][k][l];
+				pu[l] += bv[j] * du[k] * cp[j][k][l];
+				pv[l] += dv[j] * bu[k] * cp[j][k][l];
+			}
+		}
+	}
+
+	n[0] = pu[1] * pv[2] - pu[2] * pv[1];
+	n[1] = pu[2] * pv[0] - pu[0] * pv[2];
+	n[2] = pu[0] * pv[1] - pu[1] * pv[0];
 
-	(*sint)[size] = (*sint)[0];
-	(*cost)[size] = (*cost)[0];
+	return sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+}
+
+/*
+ * Tessellate one teapot patch cp into slices x stacks grid. Triangles have same
+ * winding as glEvalMesh2 and vertices are transformed same way as gdk_gl_draw_teapot
+ * does, so mesh only needs to be scaled by size.
+ */
+static void __gtkglut_teapot_patch(__gtkglut_mesh_data_struct * data, double cp[4][4][3],
+				   int slices, int stacks, gboolean solid)
+{
+	double p[3], n[3], tmp[3];
+	double u, v, len;
+	GLuint base, a;
+	int j, k, l;
+
+	base = data->num_vertices;
+
+	for (j = 0; j <= stacks; j++) {
+		v = (double) j / stacks;
+
+		for (k = 0; k <= slices; k++) {
+			u = (double) k / slices;
+
+			len = __gtkglut_bezier_eval(cp, u, v, p, n);
+
+			/*
+			 * Collapsed edge (top of lid, center of bottom) has no tangent plane,
+			 * take normal from inside of patch
+			 */
+			if (len < 1e-6) {
+				len = __gtkglut_bezier_eval(cp, u < 0.5 ? u + 1e-3 : u - 1e-3,
+							    v < 0.5 ? v + 1e-3 : v - 1e-3, tmp, n);
+			}
+
+			if (len > 0.0) {
+				for (l = 0; l < 3; l++)
+					n[l] /= len;
+			}
+
+			/*
+			 * Rotate by 270 degrees around x, scale by 0.5 and move by -1.5
+			 * along original z
+			 */
+			__gtkglut_mesh_data_vertex(data, n[0], n[2], -n[1], 0.5 * p[0],
+						   0.5 * (p[2] - 1.5), -0.5 * p[1]);
+		}
+	}
+
+	for (j = 0; j <= stacks; j++) {
+		for (k = 0; k <= slices; k++) {
+			a = base + j * (slices + 1) + k;
+
+			if (solid) {
+				if (j < stacks && k < slices) {
+					__gtkglut_mesh_data_triangle(data, a, a + slices + 1,
+								     a + slices + 2);
+					__gtkglut_mesh_data_triangle(data, a, a + slices + 2,
+								     a + 1);
+				}
+			} else {
+				if (k < slices)
+					__gtkglut_mesh_data_line(data, a, a + 1);
+
+				if (j < stacks)
+					__gtkglut_mesh_data_line(data, a, a + slices + 1);
+			}
+		}
+	}
+}
+
+/*
+ * Teapot made of all copies of its patches, each tessellated into slices x stacks grid
+ */
+static void __gtkglut_mesh_teapot(__gtkglut_mesh_data_struct * data, GLfloat param,
+				  int slices, int stacks, gboolean solid)
+{
+	double cp[4][4][3];
+	const GLfloat *point;
+	const int *patch;
+	const int *copy;
+	int num_patches, num_indices;
+	int i, c, j, k;
+
+	num_patches = __GTKGLUT_TEAPOT_FULL_PATCHES * 4 +
+	    (__GTKGLUT_TEAPOT_PATCHES - __GTKGLUT_TEAPOT_FULL_PATCHES) * 2;
+
+	if (solid)
+		num_indices = slices * stacks * 6;
+	else
+		num_indices = (slices * (stacks + 1) + stacks * (slices + 1)) * 2;
+
+	if (!__gtkglut_mesh_data_alloc(data, solid ? GL_TRIANGLES : GL_LINES,
+				       num_patches * (slices + 1) * (stacks + 1),
+				       num_patches * num_indices))
+		return;
+
+	for (i = 0; i < __GTKGLUT_TEAPOT_PATCHES; i++) {
+		patch = __gtkglut_teapot_patches[i];
+
+		for (c = 0; c < (i < __GTKGLUT_TEAPOT_FULL_PATCHES ? 4 : 2); c++) {
+			copy = __gtkglut_teapot_copies[c];
+
+			for (j = 0; j < 4; j++) {
+				for (k = 0; k < 4; k++) {
+					point = __gtkglut_teapot_points
+					    [patch[j * 4 + (copy[0] ? 3 - k : k)]];
+
+					cp[j][k][0] = point[0] * copy[1];
+					cp[j][k][1] = point[1] * copy[2];
+					cp[j][k][2] = point[2];
+				}
+			}
+
+			__gtkglut_teapot_patch(data, cp, slices, stacks, solid);
+		}
+	}
 }
 
 /*!
@@ -810,11 +1741,16 @@ void glutWireCylinder(GLdouble radius, GLdouble height, GLint slices, GLint stac
 	/*
 	 * Pre-computed circle
 	 */
-	double *sint, *cost;
+	__gtkglut_circle_table_struct *table;
+	const GLfloat *sint, *cost;
 
 	__gtkglut_test_inicialization("glutWireCylinder");
 
-	__gtkglut_circle_table(&sint, &cost, -slices);
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CYLINDER, 0.0, slices, stacks, FALSE,
+				__gtkglut_mesh_cylinder, radius, radius, height))
+		return;
+
+	table = __gtkglut_circle_table(&sint, &cost, -slices);
 
 	/*
 	 * Draw the stacks...
@@ -850,12 +1786,7 @@ void glutWireCylinder(GLdouble radius, GLdouble height, GLint slices, GLint stac
 
 	glEnd();
 
-	/*
-	 * Release sin and cos tables
-	 */
-
-	free(sint);
-	free(cost);
+	__gtkglut_circle_table_free(table);
 }
 
 /*!
@@ -887,11 +1818,16 @@ void glutSolidCylinder(GLdouble radius, GLdouble height, GLint slices, GLint sta
 	 * Pre-computed circle
 	 */
 
-	double *sint, *cost;
+	__gtkglut_circle_table_struct *table;
+	const GLfloat *sint, *cost;
 
 	__gtkglut_test_inicialization("glutSolidCylinder");
 
-	__gtkglut_circle_table(&sint, &cost, -slices);
+	if (__gtkglut_mesh_draw(__GTKGLUT_MESH_CYLINDER, 0.0, slices, stacks, TRUE,
+				__gtkglut_mesh_cylinder, radius, radius, height))
+		return;
+
+	table = __gtkglut_circle_table(&sint, &cost, -slices);
 
 	/* Cover the base and top */
 
@@ -932,10 +1868,284 @@ void glutSolidCylinder(GLdouble radius, GLdouble height, GLint slices, GLint sta
 		z1 += zStep;
 	}
 
-	/*
-	 * Release sin and cos tables
-	 */
+	__gtkglut_circle_table_free(table);
+}
+
+/*!
+ * \brief    Draw many solid spheres.
+ * \ingroup  geometry
+ * \param    radius      Sphere radius.
+ * \param    slices      The number of divisions around the z axis.
+ * \param    stacks      The number of divisions along the z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count spheres, as if glutSolidSphere() was called for every
+ * instance between glPushMatrix() and glPopMatrix(), with glMultMatrixf()
+ * of instance matrix (16 floats in column-major order) and glColor4fv()
+ * of instance color (4 floats, RGBA), if \a colors isn't NULL.  Current
+ * color is not changed.
+ *
+ * Mesh of shape is taken from mesh cache (see \a GTKGLUT_MESH_CACHE_SIZE
+ * in glutSetOption()).  With OpenGL 2.0, GL_ARB_instanced_arrays and
+ * GL_ARB_draw_instanced, all instances are drawn by one
+ * glDrawElementsInstancedARB() call with small vertex shader, which
+ * emulates fixed function lighting of first 8 lights.  Two-sided lighting,
+ * local viewer and separate specular color are not emulated, so with them
+ * (or without extensions) instances are drawn by loop of glDrawElements()
+ * over vertex arrays bound only once.
+ *
+ * \note Shader replaces current program for the draw, so instances
+ *       are never drawn with user's shaders.
+ * \see glutSolidSphere(), glutWireSphereInstanced()
+ */
+void glutSolidSphereInstanced(GLdouble radius, GLint slices, GLint stacks, int count,
+			      const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutSolidSphereInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_SPHERE, 0.0, slices, stacks, TRUE,
+				      __gtkglut_mesh_sphere, radius, radius, radius, count,
+				      matrices, colors);
+}
+
+/*!
+ * \brief    Draw many wireframe spheres.
+ * \ingroup  geometry
+ * \param    radius      Sphere radius.
+ * \param    slices      The number of divisions around the z axis.
+ * \param    stacks      The number of divisions along the z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count wireframe spheres.  Every instance is transformed by its
+ * matrix (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutWireSphere(), glutSolidSphereInstanced()
+ */
+void glutWireSphereInstanced(GLdouble radius, GLint slices, GLint stacks, int count,
+			     const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutWireSphereInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_SPHERE, 0.0, slices, stacks, FALSE,
+				      __gtkglut_mesh_sphere, radius, radius, radius, count,
+				      matrices, colors);
+}
+
+/*!
+ * \brief    Draw many solid cubes.
+ * \ingroup  geometry
+ * \param    size        The width, height and depth of the cube.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count solid cubes.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutSolidCube(), glutWireCubeInstanced()
+ */
+void glutSolidCubeInstanced(GLdouble size, int count, const GLfloat * matrices,
+			    const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutSolidCubeInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CUBE, 0.0, 1, 1, TRUE, __gtkglut_mesh_cube,
+				      size, size, size, count, matrices, colors);
+}
+
+/*!
+ * \brief    Draw many wireframe cubes.
+ * \ingroup  geometry
+ * \param    size        The width, height and depth of the cube.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count wireframe cubes.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutWireCube(), glutSolidCubeInstanced()
+ */
+void glutWireCubeInstanced(GLdouble size, int count, const GLfloat * matrices,
+			   const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutWireCubeInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CUBE, 0.0, 1, 1, FALSE, __gtkglut_mesh_cube,
+				      size, size, size, count, matrices, colors);
+}
+
+/*!
+ * \brief    Draw many solid cones.
+ * \ingroup  geometry
+ * \param    base        Cone radius at the base in the xy plane.
+ * \param    height      Height of cone in positive z direction.
+ * \param    slices      The number of divisions around the z axis.
+ * \param    stacks      The number of divisions along the z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count solid cones.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutSolidCone(), glutWireConeInstanced()
+ */
+void glutSolidConeInstanced(GLdouble base, GLdouble height, GLint slices, GLint stacks, int count,
+			    const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutSolidConeInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CONE, 0.0, slices, stacks, TRUE,
+				      __gtkglut_mesh_cone, base, base, height, count, matrices,
+				      colors);
+}
+
+/*!
+ * \brief    Draw many wireframe cones.
+ * \ingroup  geometry
+ * \param    base        Cone radius at the base in the xy plane.
+ * \param    height      Height of cone in positive z direction.
+ * \param    slices      The number of divisions around the z axis.
+ * \param    stacks      The number of divisions along the z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count wireframe cones.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutWireCone(), glutSolidConeInstanced()
+ */
+void glutWireConeInstanced(GLdouble base, GLdouble height, GLint slices, GLint stacks, int count,
+			   const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutWireConeInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CONE, 0.0, slices, stacks, FALSE,
+				      __gtkglut_mesh_cone, base, base, height, count, matrices,
+				      colors);
+}
+
+/*!
+ * \brief    Draw many solid tori.
+ * \ingroup  geometry
+ * \param    innerRadius    Radius of ``tube''
+ * \param    outerRadius    Radius of ``path''
+ * \param    nsides         Facets around ``tube''
+ * \param    rings          Joints along ``path''
+ * \param    count          Number of instances.
+ * \param    matrices       Transformation of every instance.
+ * \param    colors         Color of every instance or NULL.
+ *
+ * Draws \a count solid tori.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutSolidTorus(), glutWireTorusInstanced()
+ */
+void glutSolidTorusInstanced(GLdouble innerRadius, GLdouble outerRadius, GLint nsides, GLint rings,
+			     int count, const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutSolidTorusInstanced");
+
+	if (outerRadius == 0.0)
+		return;
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_TORUS, innerRadius / outerRadius, nsides,
+				      rings, TRUE, __gtkglut_mesh_torus, outerRadius, outerRadius,
+				      outerRadius, count, matrices, colors);
+}
+
+/*!
+ * \brief    Draw many wireframe tori.
+ * \ingroup  geometry
+ * \param    innerRadius    Radius of ``tube''
+ * \param    outerRadius    Radius of ``path''
+ * \param    nsides         Facets around ``tube''
+ * \param    rings          Joints along ``path''
+ * \param    count          Number of instances.
+ * \param    matrices       Transformation of every instance.
+ * \param    colors         Color of every instance or NULL.
+ *
+ * Draws \a count wireframe tori.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutWireTorus(), glutSolidTorusInstanced()
+ */
+void glutWireTorusInstanced(GLdouble innerRadius, GLdouble outerRadius, GLint nsides, GLint rings,
+			    int count, const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutWireTorusInstanced");
+
+	if (outerRadius == 0.0)
+		return;
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_TORUS, innerRadius / outerRadius, nsides,
+				      rings, FALSE, __gtkglut_mesh_torus, outerRadius, outerRadius,
+				      outerRadius, count, matrices, colors);
+}
+
+/*!
+ * \brief    Draw many solid cylinders.
+ * \ingroup  geometry
+ * \param    radius      Radius of the cylinder.
+ * \param    height      Z height.
+ * \param    slices      Divisions around z axis.
+ * \param    stacks      Divisions along z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count solid cylinders.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutSolidCylinder(), glutWireCylinderInstanced()
+ */
+void glutSolidCylinderInstanced(GLdouble radius, GLdouble height, GLint slices, GLint stacks,
+				int count, const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutSolidCylinderInstanced");
+
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CYLINDER, 0.0, slices, stacks, TRUE,
+				      __gtkglut_mesh_cylinder, radius, radius, height, count,
+				      matrices, colors);
+}
+
+/*!
+ * \brief    Draw many wireframe cylinders.
+ * \ingroup  geometry
+ * \param    radius      Radius of the cylinder.
+ * \param    height      Z height.
+ * \param    slices      Divisions around z axis.
+ * \param    stacks      Divisions along z axis.
+ * \param    count       Number of instances.
+ * \param    matrices    Transformation of every instance.
+ * \param    colors      Color of every instance or NULL.
+ *
+ * Draws \a count wireframe cylinders.  Every instance is transformed by its matrix
+ * (16 floats in column-major order) and colored by its color (4 floats),
+ * see glutSolidSphereInstanced().
+ *
+ * \see glutWireCylinder(), glutSolidCylinderInstanced()
+ */
+void glutWireCylinderInstanced(GLdouble radius, GLdouble height, GLint slices, GLint stacks,
+			       int count, const GLfloat * matrices, const GLfloat * colors)
+{
+	__gtkglut_test_inicialization("glutWireCylinderInstanced");
 
-	free(sint);
-	free(cost);
+	__gtkglut_mesh_draw_instanced(__GTKGLUT_MESH_CYLINDER, 0.0, slices, stacks, FALSE,
+				      __gtkglut_mesh_cylinder, radius, radius, height, count,
+				      matrices, colors);
 }
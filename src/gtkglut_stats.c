@@ -0,0 +1,426 @@
+/*!
+ * \file  gtkglut_stats.c
+ * \brief GtkGLUT frame statistics.
+ */
+
+/*
+ * GtkGLUT frame statistics.
+ *
+ * Copyright (c) 2008-2026 Jan Friesse. All Rights Reserved.
+ * Written by Jan Friesse, <jfriesse@gmail.comt>
+ * Creation date: Sat Oct 17 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Except as contained in this notice, the name of Jan Friesse shall not be
+ * used in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Jan Friesse.
+ */
+
+#include "GL/gtkglut.h"
+#include "gtkglut_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+/*
+ * Resolve ARB_timer_query (or EXT_timer_query) functions. Must be called with
+ * current GL context.
+ */
+static void __gtkglut_timer_query_init(void)
+{
+	char *get_ui64v_name;
+
+	__gtkglut_context->timer_query_supported = FALSE;
+
+	if (gdk_gl_query_gl_extension("GL_ARB_timer_query")) {
+		get_ui64v_name = "glGetQueryObjectui64v";
+	} else if (gdk_gl_query_gl_extension("GL_EXT_timer_query")) {
+		get_ui64v_name = "glGetQueryObjectui64vEXT";
+	} else {
+		return;
+	}
+
+	__gtkglut_context->gl_gen_queries = (void (APIENTRY *) (GLsizei, GLuint *))
+	    glutGetProcAddress("glGenQueries");
+	__gtkglut_context->gl_delete_queries = (void (APIENTRY *) (GLsizei, const GLuint *))
+	    glutGetProcAddress("glDeleteQueries");
+	__gtkglut_context->gl_begin_query = (void (APIENTRY *) (GLenum, GLuint))
+	    glutGetProcAddress("glBeginQuery");
+	__gtkglut_context->gl_end_query = (void (APIENTRY *) (GLenum))
+	    glutGetProcAddress("glEndQuery");
+	__gtkglut_context->gl_get_query_objectiv = (void (APIENTRY *) (GLuint, GLenum, GLint *))
+	    glutGetProcAddress("glGetQueryObjectiv");
+	__gtkglut_context->gl_get_query_objectui64v =
+	    (void (APIENTRY *) (GLuint, GLenum, guint64 *))glutGetProcAddress(get_ui64v_name);
+
+	__gtkglut_context->timer_query_supported = __gtkglut_context->gl_gen_queries &&
+	    __gtkglut_context->gl_delete_queries && __gtkglut_context->gl_begin_query &&
+	    __gtkglut_context->gl_end_query && __gtkglut_context->gl_get_query_objectiv &&
+	    __gtkglut_context->gl_get_query_objectui64v;
+}
+
+/*
+ * Store time in nanoseconds to ring of samples
+ */
+static void __gtkglut_frame_time_add(__gtkglut_frame_time_struct * frame_time, gint64 nsec)
+{
+	gint64 usec;
+
+	usec = nsec / 1000;
+
+	if (usec > G_MAXINT)
+		usec = G_MAXINT;
+
+	frame_time->samples[frame_time->count % __GTKGLUT_FRAME_STATS_SAMPLES] = (int)usec;
+
+	/*
+	 * Keep count from overflow, but still greater then size of ring
+	 */
+	if (++frame_time->count == 2 * __GTKGLUT_FRAME_STATS_SAMPLES)
+		frame_time->count = __GTKGLUT_FRAME_STATS_SAMPLES;
+}
+
+static int __gtkglut_frame_time_compare(const void *a, const void *b)
+{
+	int ia, ib;
+
+	ia = *(const int *)a;
+	ib = *(const int *)b;
+
+	return (ia > ib) - (ia < ib);
+}
+
+/*
+ * Compute min/avg/p99/max of samples in ring
+ */
+static void __gtkglut_frame_time_summary(__gtkglut_frame_time_struct * frame_time,
+					 GLUTframeTime * res)
+{
+	int sorted[__GTKGLUT_FRAME_STATS_SAMPLES];
+	gint64 sum;
+	int n;
+	int i;
+
+	n = MIN(frame_time->count, __GTKGLUT_FRAME_STATS_SAMPLES);
+
+	res->samples = n;
+
+	if (n == 0) {
+		res->min = res->avg = res->p99 = res->max = -1;
+		return;
+	}
+
+	memcpy(sorted, frame_time->samples, n * sizeof(int));
+	qsort(sorted, n, sizeof(int), __gtkglut_frame_time_compare);
+
+	sum = 0;
+	for (i = 0; i < n; i++)
+		sum += sorted[i];
+
+	res->min = sorted[0];
+	res->avg = (int)(sum / n);
+	res->p99 = sorted[(n * 99 + 99) / 100 - 1];
+	res->max = sorted[n - 1];
+}
+
+/*
+ * Return frame statistics of window, allocate them if needed. Statistics of
+ * previous collecting (before option was disabled) are dropped.
+ */
+static __gtkglut_frame_stats_struct *__gtkglut_frame_stats_get(__gtkglut_window_struct *
+							       glut_window)
+{
+	__gtkglut_frame_stats_struct *stats;
+	GLuint queries[__GTKGLUT_FRAME_STATS_QUERIES];
+	gboolean queries_generated;
+
+	stats = glut_window->frame_stats;
+
+	if (stats && stats->epoch == __gtkglut_context->frame_stats_epoch)
+		return stats;
+
+	if (!stats) {
+		stats = (__gtkglut_frame_stats_struct *) malloc(sizeof(__gtkglut_frame_stats_struct));
+
+		if (!stats)
+			__gtkglut_lowmem();
+
+		queries_generated = FALSE;
+	} else {
+		/*
+		 * Query objects are reused, pending results are thrown away
+		 */
+		memcpy(queries, stats->queries, sizeof(queries));
+		queries_generated = stats->queries_generated;
+	}
+
+	memset(stats, 0, sizeof(__gtkglut_frame_stats_struct));
+
+	if (queries_generated)
+		memcpy(stats->queries, queries, sizeof(queries));
+
+	stats->queries_generated = queries_generated;
+	stats->epoch = __gtkglut_context->frame_stats_epoch;
+
+	glut_window->frame_stats = stats;
+
+	return stats;
+}
+
+/*
+ * Read results of finished GPU timer queries. Never waits for GPU.
+ */
+static void __gtkglut_frame_stats_collect(__gtkglut_frame_stats_struct * stats)
+{
+	GLint available;
+	guint64 elapsed;
+	GLuint query;
+
+	while (stats->query_pending > 0) {
+		query = stats->queries[stats->query_first];
+
+		available = 0;
+		__gtkglut_context->gl_get_query_objectiv(query, GL_QUERY_RESULT_AVAILABLE,
+							 &available);
+
+		if (!available)
+			break;
+
+		__gtkglut_context->gl_get_query_objectui64v(query, GL_QUERY_RESULT, &elapsed);
+		__gtkglut_frame_time_add(&stats->gpu_time, (gint64) elapsed);
+
+		stats->query_first = (stats->query_first + 1) % __GTKGLUT_FRAME_STATS_QUERIES;
+		stats->query_pending--;
+	}
+}
+
+void __gtkglut_frame_stats_begin(__gtkglut_window_struct * glut_window)
+{
+	__gtkglut_frame_stats_struct *stats;
+	int query;
+
+	stats = __gtkglut_frame_stats_get(glut_window);
+
+	if (__gtkglut_context->timer_query_supported == __GTKGLUT_UNDEFINED)
+		__gtkglut_timer_query_init();
+
+	if (__gtkglut_context->timer_query_supported) {
+		if (!stats->queries_generated) {
+			__gtkglut_context->gl_gen_queries(__GTKGLUT_FRAME_STATS_QUERIES,
+							  stats->queries);
+			stats->queries_generated = TRUE;
+		}
+
+		__gtkglut_frame_stats_collect(stats);
+
+		/*
+		 * If all queries are still pending, GPU time of this frame is not measured
+		 */
+		if (stats->query_pending < __GTKGLUT_FRAME_STATS_QUERIES) {
+			query = (stats->query_first + stats->query_pending) %
+			    __GTKGLUT_FRAME_STATS_QUERIES;
+
+			__gtkglut_context->gl_begin_query(GL_TIME_ELAPSED, stats->queries[query]);
+			stats->query_active = TRUE;
+		}
+	}
+
+	stats->display_start = __gtkglut_get_time_nsec();
+}
+
+void __gtkglut_frame_stats_end(__gtkglut_window_struct * glut_window, int window_id)
+{
+	__gtkglut_frame_stats_struct *stats;
+	gint64 now;
+
+	now = __gtkglut_get_time_nsec();
+
+	stats = glut_window->frame_stats;
+
+	__gtkglut_frame_time_add(&stats->display_time, now - stats->display_start);
+	stats->frames++;
+
+	if (stats->query_active) {
+		/*
+		 * Display callback may change current window
+		 */
+		if (glutGetWindow() != window_id)
+			glutSetWindow(window_id);
+
+		__gtkglut_context->gl_end_query(GL_TIME_ELAPSED);
+		stats->query_active = FALSE;
+		stats->query_pending++;
+	}
+}
+
+void __gtkglut_frame_stats_swap(__gtkglut_window_struct * glut_window)
+{
+	__gtkglut_frame_stats_struct *stats;
+	gint64 now;
+
+	now = __gtkglut_get_time_nsec();
+
+	stats = __gtkglut_frame_stats_get(glut_window);
+
+	if (stats->last_swap)
+		__gtkglut_frame_time_add(&stats->swap_interval, now - stats->last_swap);
+
+	stats->last_swap = now;
+}
+
+void __gtkglut_frame_stats_free(__gtkglut_window_struct * glut_window, gboolean in_context)
+{
+	__gtkglut_frame_stats_struct *stats;
+
+	stats = glut_window->frame_stats;
+
+	if (!stats)
+		return;
+
+	if (stats->queries_generated && in_context)
+		__gtkglut_context->gl_delete_queries(__GTKGLUT_FRAME_STATS_QUERIES, stats->queries);
+
+	free(stats);
+	glut_window->frame_stats = NULL;
+}
+
+int __gtkglut_frame_stats_get_avg(__gtkglut_window_struct * glut_window, int state)
+{
+	__gtkglut_frame_stats_struct *stats;
+	__gtkglut_frame_time_struct *frame_time;
+	GLUTframeTime res;
+
+	stats = glut_window->frame_stats;
+
+	if (!stats)
+		return -1;
+
+	switch (state) {
+	case GTKGLUT_FRAME_DISPLAY_TIME:
+		frame_time = &stats->display_time;
+		break;
+
+	case GTKGLUT_FRAME_SWAP_INTERVAL:
+		frame_time = &stats->swap_interval;
+		break;
+
+	default:
+		frame_time = &stats->gpu_time;
+		break;
+	}
+
+	__gtkglut_frame_time_summary(frame_time, &res);
+
+	return res.avg;
+}
+
+/*!
+ * \brief    Get frame statistics of the current window.
+ * \ingroup  window
+ * \param    stats    Where to store statistics.
+ * \return   1 if statistics were collected for window, otherwise 0.
+ *
+ * Statistics are collected only while \a GTKGLUT_FRAME_STATS option
+ * is enabled (see glutSetOption()).  Values are computed from last
+ * 128 frames and are in microseconds:
+ *
+ * - \a display_time  time spent in display callback
+ * - \a swap_interval interval between glutSwapBuffers() calls
+ * - \a gpu_time      GPU time of commands issued from display callback,
+ *                    measured by GL_ARB_timer_query.  GPU results are
+ *                    read few frames later, so pipeline is never stalled.
+ *
+ * For every value is stored number of samples and its minimum, average,
+ * 99th percentile and maximum.  Without samples (for example \a gpu_time
+ * without timer query extension), all values except \a samples are -1.
+ * \a frames is total number of displayed frames.
+ *
+ * \note Display callback must not use its own GL_TIME_ELAPSED query,
+ *       while GPU time is measured.
+ * \see glutResetFrameStats(), glutGet()
+ */
+int glutGetFrameStats(GLUTframeStats * stats)
+{
+	__gtkglut_window_struct *glut_window;
+	__gtkglut_frame_stats_struct *frame_stats;
+
+	__gtkglut_test_inicialization("glutGetFrameStats");
+
+	memset(stats, 0, sizeof(GLUTframeStats));
+	stats->display_time.min = stats->display_time.avg = -1;
+	stats->display_time.p99 = stats->display_time.max = -1;
+	stats->swap_interval = stats->gpu_time = stats->display_time;
+
+	glut_window = __gtkglut_get_active_window_with_warning("glutGetFrameStats");
+
+	if (!glut_window || !glut_window->frame_stats)
+		return 0;
+
+	frame_stats = glut_window->frame_stats;
+
+	stats->frames = frame_stats->frames;
+	__gtkglut_frame_time_summary(&frame_stats->display_time, &stats->display_time);
+	__gtkglut_frame_time_summary(&frame_stats->swap_interval, &stats->swap_interval);
+	__gtkglut_frame_time_summary(&frame_stats->gpu_time, &stats->gpu_time);
+
+	return 1;
+}
+
+/*!
+ * \brief    Reset frame statistics of the current window.
+ * \ingroup  window
+ *
+ * All samples and frame counter of *current window* are cleared.
+ * Results of GPU timer queries, which are still pending, are
+ * counted to new statistics.
+ *
+ * \see glutGetFrameStats()
+ */
+void glutResetFrameStats(void)
+{
+	__gtkglut_window_struct *glut_window;
+	__gtkglut_frame_stats_struct *stats;
+
+	__gtkglut_test_inicialization("glutResetFrameStats");
+
+	glut_window = __gtkglut_get_active_window_with_warning("glutResetFrameStats");
+
+	if (!glut_window || !glut_window->frame_stats)
+		return;
+
+	stats = glut_window->frame_stats;
+
+	stats->frames = 0;
+	stats->last_swap = 0;
+	stats->display_time.count = 0;
+	stats->swap_interval.count = 0;
+	stats->gpu_time.count = 0;
+}
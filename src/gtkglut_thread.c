@@ -0,0 +1,304 @@
+/*!
+ * \file  gtkglut_thread.c
+ * \brief GtkGLUT cross-thread posting.
+ */
+
+/*
+ * GtkGLUT cross-thread posting.
+ *
+ * Copyright (c) 2008-2026 Jan Friesse. All Rights Reserved.
+ * Written by Jan Friesse, <jfriesse@gmail.comt>
+ * Creation date: Sat Oct 17 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Except as contained in this notice, the name of Jan Friesse shall not be
+ * used in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Jan Friesse.
+ */
+
+
+#include "GL/gtkglut.h"
+#include "gtkglut_internal.h"
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#define __GTKGLUT_HAVE_EVENTFD
+#endif
+
+/*
+ * Requests from other threads are pushed to lock-free stack (singly linked
+ * list with head in context). Main thread takes whole stack at once by atomic
+ * exchange of head and reverses it, so requests are processed in order they
+ * were posted. Only producer, which finds stack empty, wakes main loop up, so
+ * burst of posts costs one wakeup.
+ */
+
+/*
+ * Push task to stack. Return TRUE, if stack was empty.
+ */
+static gboolean __gtkglut_thread_queue_push(__gtkglut_thread_task_struct * task)
+{
+	gpointer head;
+
+	do {
+		head = g_atomic_pointer_get(&__gtkglut_context->thread_queue);
+		task->next = (__gtkglut_thread_task_struct *) head;
+	} while (!g_atomic_pointer_compare_and_exchange(&__gtkglut_context->thread_queue, head,
+							task));
+
+	return head == NULL;
+}
+
+/*
+ * Take all tasks from stack. Returned list is in post order.
+ */
+static __gtkglut_thread_task_struct *__gtkglut_thread_queue_take_all(void)
+{
+	gpointer head;
+	__gtkglut_thread_task_struct *task;
+	__gtkglut_thread_task_struct *next;
+	__gtkglut_thread_task_struct *res;
+
+	do {
+		head = g_atomic_pointer_get(&__gtkglut_context->thread_queue);
+	} while (head != NULL &&
+		 !g_atomic_pointer_compare_and_exchange(&__gtkglut_context->thread_queue, head,
+							NULL));
+
+	/*
+	 * Reverse LIFO to FIFO
+	 */
+	res = NULL;
+
+	for (task = (__gtkglut_thread_task_struct *) head; task; task = next) {
+		next = task->next;
+		task->next = res;
+		res = task;
+	}
+
+	return res;
+}
+
+/*
+ * Push task and wake main loop up if needed
+ */
+static void __gtkglut_thread_post(__gtkglut_thread_task_struct * task)
+{
+#ifdef __GTKGLUT_HAVE_EVENTFD
+	guint64 value;
+#endif
+
+	if (!__gtkglut_thread_queue_push(task))
+		return;
+
+#ifdef __GTKGLUT_HAVE_EVENTFD
+	if (__gtkglut_context->thread_fd.fd >= 0) {
+		value = 1;
+
+		if (write(__gtkglut_context->thread_fd.fd, &value, sizeof(value)) == sizeof(value))
+			return;
+	}
+#endif
+
+	g_main_context_wakeup(NULL);
+}
+
+/*
+ * Thread source. It's ready, when there is something in queue.
+ */
+static gboolean __gtkglut_thread_source_prepare(GSource * source, gint * timeout)
+{
+
+	*timeout = -1;
+
+	return g_atomic_pointer_get(&__gtkglut_context->thread_queue) != NULL;
+}
+
+static gboolean __gtkglut_thread_source_check(GSource * source)
+{
+#ifdef __GTKGLUT_HAVE_EVENTFD
+	guint64 value;
+
+	if (__gtkglut_context->thread_fd.revents & G_IO_IN) {
+		/*
+		 * Reset counter. Tasks posted later will write again.
+		 */
+		if (read(__gtkglut_context->thread_fd.fd, &value, sizeof(value)) < 0) {
+			value = 0;
+		}
+	}
+#endif
+
+	return g_atomic_pointer_get(&__gtkglut_context->thread_queue) != NULL;
+}
+
+/*
+ * Execute all posted tasks. Tasks posted while executing are processed in next
+ * iteration.
+ */
+static gboolean __gtkglut_thread_source_dispatch(GSource * source, GSourceFunc callback,
+						 gpointer user_data)
+{
+	__gtkglut_thread_task_struct *task;
+	__gtkglut_thread_task_struct *next;
+	__gtkglut_window_struct *glut_window;
+
+	for (task = __gtkglut_thread_queue_take_all(); task; task = next) {
+		next = task->next;
+
+		if (task->func) {
+			task->func(task->data);
+		} else {
+			/*
+			 * Window may be destroyed after post
+			 */
+			glut_window = __gtkglut_get_window_by_id(task->window_id);
+
+			if (glut_window)
+				__gtkglut_queue_window_redisplay(glut_window, task->window_id);
+		}
+
+		free(task);
+	}
+
+	return TRUE;
+}
+
+static GSourceFuncs __gtkglut_thread_source_funcs = {
+	__gtkglut_thread_source_prepare,
+	__gtkglut_thread_source_check,
+	__gtkglut_thread_source_dispatch,
+	NULL
+};
+
+/*
+ * Create and attach thread source. It must exist before any thread can post,
+ * so it's created with context.
+ */
+GSource *__gtkglut_thread_source_new(void)
+{
+	GSource *source;
+
+	source = g_source_new(&__gtkglut_thread_source_funcs, sizeof(GSource));
+	g_source_set_priority(source, G_PRIORITY_DEFAULT);
+
+	__gtkglut_context->thread_fd.fd = -1;
+	__gtkglut_context->thread_fd.events = G_IO_IN;
+	__gtkglut_context->thread_fd.revents = 0;
+
+#ifdef __GTKGLUT_HAVE_EVENTFD
+	__gtkglut_context->thread_fd.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (__gtkglut_context->thread_fd.fd >= 0) {
+		g_source_add_poll(source, &__gtkglut_context->thread_fd);
+	}
+#endif
+
+	g_source_attach(source, NULL);
+
+	return source;
+}
+
+/*
+ * Allocate new task
+ */
+static __gtkglut_thread_task_struct *__gtkglut_thread_task_new(void)
+{
+	__gtkglut_thread_task_struct *task;
+
+	task = (__gtkglut_thread_task_struct *) malloc(sizeof(__gtkglut_thread_task_struct));
+	if (!task)
+		__gtkglut_lowmem();
+
+	task->next = NULL;
+	task->func = NULL;
+	task->data = NULL;
+	task->window_id = 0;
+
+	return task;
+}
+
+/*!
+ * \defgroup thread Thread Support
+ *
+ * GtkGLUT API must be called only from thread, which runs
+ * main loop.  Functions in this module are exception, they
+ * can be called from any thread after glutInit().  Posted
+ * requests are executed by main loop, in order they were
+ * posted.  Posting doesn't take any lock, only first post
+ * to empty queue wakes main loop up.
+ *
+ * With GLib older than 2.32, g_thread_init() must be called
+ * before glutInit().
+ */
+
+/*!
+ * \brief    Mark window as needing a redisplay from any thread.
+ * \ingroup  thread
+ * \param    win    GtkGLUT window id.
+ *
+ * Works like glutPostWindowRedisplay(), but it can be called
+ * from any thread.  Request is silently ignored, if window is
+ * destroyed before main loop processes it.
+ *
+ * \see glutPostWindowRedisplay(), glutThreadPostTask()
+ */
+void glutThreadPostWindowRedisplay(int win)
+{
+	__gtkglut_thread_task_struct *task;
+
+	__gtkglut_test_inicialization("glutThreadPostWindowRedisplay");
+
+	task = __gtkglut_thread_task_new();
+	task->window_id = win;
+
+	__gtkglut_thread_post(task);
+}
+
+/*!
+ * \brief    Run function in main loop from any thread.
+ * \ingroup  thread
+ * \param    func    Function to call from main loop.
+ * \param    data    Arbitrary data; passed to \a func .
+ *
+ * \a func is called from main loop thread, so it can use
+ * whole GtkGLUT API.  Current window is not defined, when
+ * \a func is called, so use glutSetWindow() if you need it.
+ *
+ * \see glutThreadPostWindowRedisplay()
+ */
+void glutThreadPostTask(void (*func) (void *data), void *data)
+{
+	__gtkglut_thread_task_struct *task;
+
+	__gtkglut_test_inicialization("glutThreadPostTask");
+
+	if (func == NULL) {
+		__gtkglut_warning("glutThreadPostTask", "Posting NULL function doesn't make sense.");
+
+		return;
+	}
+
+	task = __gtkglut_thread_task_new();
+	task->func = func;
+	task->data = data;
+
+	__gtkglut_thread_post(task);
+}
@@ -0,0 +1,1094 @@
+/*!
+ * \file  gtkglut_timer.c
+ * \brief GtkGLUT timers.
+ */
+
+/*
+ * GtkGLUT timers.
+ *
+ * Copyright (c) 2008-2026 Jan Friesse. All Rights Reserved.
+ * Written by Jan Friesse, <jfriesse@gmail.comt>
+ * Creation date: Sat Oct 17 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Except as contained in this notice, the name of Jan Friesse shall not be
+ * used in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Jan Friesse.
+ */
+
+#ifdef __linux__
+#define _POSIX_C_SOURCE 199309L
+#define __GTKGLUT_HAVE_CLOCK_GETTIME
+#define __GTKGLUT_HAVE_TIMERFD
+#endif
+
+#include "GL/gtkglut.h"
+#include "gtkglut_internal.h"
+
+#ifdef __GTKGLUT_HAVE_CLOCK_GETTIME
+#include <time.h>
+#endif
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Timers are kept in hierarchical timer wheel with millisecond tick. Every
+ * level has 256 slots, level 0 holds timers expiring in next 256 ticks, level 1
+ * in next 65536 ticks and so on. When level 0 index wraps, one slot of upper
+ * level is cascaded (redistributed) to lower levels. Arm and cancel are O(1),
+ * timer nodes are allocated from slabs and reused, and handle contains
+ * generation of node, so stale handle never cancels reused node.
+ *
+ * Precise timers have microsecond resolution. They share nodes (and so handles)
+ * with wheel, but are kept in binary min-heap. On Linux, main loop is woken up
+ * by timerfd, otherwise poll timeout is rounded down and rest of time is
+ * spent by polling with zero timeout.
+ */
+
+#define __GTKGLUT_TIMER_FREE      0
+#define __GTKGLUT_TIMER_ARMED     1
+#define __GTKGLUT_TIMER_RUNNING   2
+#define __GTKGLUT_TIMER_CANCELLED 3
+
+#define __GTKGLUT_TIMER_WHEEL_MASK  (__GTKGLUT_TIMER_WHEEL_SIZE - 1)
+#define __GTKGLUT_TIMER_INDEX_MASK  ((1 << __GTKGLUT_TIMER_INDEX_BITS) - 1)
+#define __GTKGLUT_TIMER_GENERATION_MASK  0x7FF
+
+/*
+ * Empty circular list
+ */
+static void __gtkglut_timer_list_init(__gtkglut_timer_struct * head)
+{
+	head->next = head->prev = head;
+}
+
+static void __gtkglut_timer_list_add(__gtkglut_timer_struct * head,
+				     __gtkglut_timer_struct * timer)
+{
+	timer->prev = head->prev;
+	timer->next = head;
+	head->prev->next = timer;
+	head->prev = timer;
+}
+
+static void __gtkglut_timer_list_del(__gtkglut_timer_struct * timer)
+{
+	timer->prev->next = timer->next;
+	timer->next->prev = timer->prev;
+	timer->next = timer->prev = timer;
+}
+
+/*
+ * Move all items from list src to empty list dst
+ */
+static void __gtkglut_timer_list_move(__gtkglut_timer_struct * src,
+				      __gtkglut_timer_struct * dst)
+{
+
+	if (src->next == src) {
+		__gtkglut_timer_list_init(dst);
+		return;
+	}
+
+	dst->next = src->next;
+	dst->prev = src->prev;
+	dst->next->prev = dst;
+	dst->prev->next = dst;
+
+	__gtkglut_timer_list_init(src);
+}
+
+/*
+ * Monotonic time in microseconds. g_get_monotonic_time() is available since
+ * GLib 2.28, older GLib has only wall clock.
+ */
+gint64 __gtkglut_get_time_usec(void)
+{
+#if GLIB_CHECK_VERSION(2, 28, 0)
+	return g_get_monotonic_time();
+#else
+	GTimeVal tv;
+#ifdef __GTKGLUT_HAVE_CLOCK_GETTIME
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (gint64) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	}
+#endif
+
+	g_get_current_time(&tv);
+
+	return (gint64) tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec;
+#endif
+}
+
+/*
+ * Monotonic time in nanoseconds
+ */
+gint64 __gtkglut_get_time_nsec(void)
+{
+#ifdef __GTKGLUT_HAVE_CLOCK_GETTIME
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (gint64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+	}
+#endif
+
+	return __gtkglut_get_time_usec() * 1000;
+}
+
+/*
+ * Return current time in wheel ticks (milliseconds)
+ */
+static gint64 __gtkglut_timer_now(__gtkglut_timer_wheel_struct * wheel)
+{
+
+	return (__gtkglut_get_time_usec() - wheel->base_time) / 1000;
+}
+
+/*
+ * Insert armed timer to right slot of wheel
+ */
+static void __gtkglut_timer_wheel_insert(__gtkglut_timer_wheel_struct * wheel,
+					 __gtkglut_timer_struct * timer)
+{
+	gint64 delta;
+	gint64 expires;
+	int level;
+	int shift;
+
+	expires = timer->expires;
+	delta = expires - wheel->time;
+
+	if (delta < 0) {
+		/*
+		 * Already expired -> execute on next tick
+		 */
+		expires = wheel->time;
+		delta = 0;
+	}
+
+	for (level = 0; level < __GTKGLUT_TIMER_WHEEL_LEVELS - 1; level++) {
+		if (delta < ((gint64) 1 << (__GTKGLUT_TIMER_WHEEL_BITS * (level + 1))))
+			break;
+	}
+
+	shift = __GTKGLUT_TIMER_WHEEL_BITS * level;
+
+	if (delta >= ((gint64) 1 << (__GTKGLUT_TIMER_WHEEL_BITS * __GTKGLUT_TIMER_WHEEL_LEVELS))) {
+		/*
+		 * Too far in future. Put it to last slot, it will be cascaded again
+		 */
+		expires = wheel->time +
+		    ((gint64) 1 << (__GTKGLUT_TIMER_WHEEL_BITS * __GTKGLUT_TIMER_WHEEL_LEVELS)) - 1;
+	}
+
+	__gtkglut_timer_list_add(&wheel->
+				 slots[level][(expires >> shift) & __GTKGLUT_TIMER_WHEEL_MASK], timer);
+	timer->level = level;
+	wheel->level_count[level]++;
+}
+
+/*
+ * Remove armed timer from wheel
+ */
+static void __gtkglut_timer_wheel_remove(__gtkglut_timer_wheel_struct * wheel,
+					 __gtkglut_timer_struct * timer)
+{
+
+	__gtkglut_timer_list_del(timer);
+	wheel->level_count[timer->level]--;
+}
+
+/*
+ * Redistribute timers from slot of level to lower levels
+ */
+static void __gtkglut_timer_wheel_cascade(__gtkglut_timer_wheel_struct * wheel, int level,
+					  int index)
+{
+	__gtkglut_timer_struct list;
+	__gtkglut_timer_struct *timer;
+
+	__gtkglut_timer_list_move(&wheel->slots[level][index], &list);
+
+	while (list.next != &list) {
+		timer = list.next;
+
+		__gtkglut_timer_list_del(timer);
+		wheel->level_count[level]--;
+
+		__gtkglut_timer_wheel_insert(wheel, timer);
+	}
+}
+
+/*
+ * Return node with index (starting from 1) or NULL
+ */
+static __gtkglut_timer_struct *__gtkglut_timer_get_node(__gtkglut_timer_wheel_struct * wheel,
+							int index)
+{
+	int slab;
+
+	index--;
+	slab = index / __GTKGLUT_TIMER_SLAB_SIZE;
+
+	if (index < 0 || (guint) slab >= wheel->slabs->len)
+		return NULL;
+
+	return (__gtkglut_timer_struct *) g_ptr_array_index(wheel->slabs, slab) +
+	    index % __GTKGLUT_TIMER_SLAB_SIZE;
+}
+
+/*
+ * Get free timer node. If there is no free node, new slab is allocated
+ */
+static __gtkglut_timer_struct *__gtkglut_timer_alloc(__gtkglut_timer_wheel_struct * wheel)
+{
+	__gtkglut_timer_struct *slab;
+	__gtkglut_timer_struct *timer;
+	int first_index;
+	int i;
+
+	if (!wheel->free_list) {
+		first_index = wheel->slabs->len * __GTKGLUT_TIMER_SLAB_SIZE + 1;
+
+		if (first_index + __GTKGLUT_TIMER_SLAB_SIZE > __GTKGLUT_TIMER_INDEX_MASK) {
+			return NULL;
+		}
+
+		slab = (__gtkglut_timer_struct *)
+		    malloc(sizeof(__gtkglut_timer_struct) * __GTKGLUT_TIMER_SLAB_SIZE);
+		if (!slab)
+			__gtkglut_lowmem();
+
+		g_ptr_array_add(wheel->slabs, slab);
+
+		/*
+		 * Link slab to free list in reverse order, so lower indexes are used first
+		 */
+		for (i = __GTKGLUT_TIMER_SLAB_SIZE - 1; i >= 0; i--) {
+			slab[i].handle = first_index + i;
+			slab[i].state = __GTKGLUT_TIMER_FREE;
+			slab[i].next = wheel->free_list;
+			wheel->free_list = &slab[i];
+		}
+	}
+
+	timer = wheel->free_list;
+	wheel->free_list = timer->next;
+
+	timer->next = timer->prev = timer;
+
+	return timer;
+}
+
+/*
+ * Return timer node to free list. Generation in handle is increased.
+ */
+static void __gtkglut_timer_free(__gtkglut_timer_wheel_struct * wheel,
+				 __gtkglut_timer_struct * timer)
+{
+	int generation;
+
+	generation = ((timer->handle >> __GTKGLUT_TIMER_INDEX_BITS) + 1) &
+	    __GTKGLUT_TIMER_GENERATION_MASK;
+
+	timer->handle = (generation << __GTKGLUT_TIMER_INDEX_BITS) |
+	    (timer->handle & __GTKGLUT_TIMER_INDEX_MASK);
+	timer->state = __GTKGLUT_TIMER_FREE;
+	timer->func = NULL;
+
+	timer->next = wheel->free_list;
+	wheel->free_list = timer;
+
+	if (timer->level != __GTKGLUT_TIMER_PRECISE)
+		wheel->no_timers--;
+}
+
+/*
+ * Monotonic time in microseconds used by precise timers. On Linux, it has same
+ * clock as timerfd.
+ */
+static gint64 __gtkglut_timer_precise_now(void)
+{
+
+	return __gtkglut_get_time_nsec() / 1000;
+}
+
+/*
+ * Store timer to position i of heap
+ */
+static void __gtkglut_timer_heap_set(GPtrArray * heap, int i, __gtkglut_timer_struct * timer)
+{
+
+	g_ptr_array_index(heap, i) = timer;
+	timer->heap_index = i;
+}
+
+/*
+ * Move timer on position i of heap up, till heap property holds
+ */
+static void __gtkglut_timer_heap_up(GPtrArray * heap, int i)
+{
+	__gtkglut_timer_struct *timer;
+	__gtkglut_timer_struct *parent;
+
+	timer = (__gtkglut_timer_struct *) g_ptr_array_index(heap, i);
+
+	while (i > 0) {
+		parent = (__gtkglut_timer_struct *) g_ptr_array_index(heap, (i - 1) / 2);
+
+		if (parent->expires <= timer->expires)
+			break;
+
+		__gtkglut_timer_heap_set(heap, i, parent);
+		i = (i - 1) / 2;
+	}
+
+	__gtkglut_timer_heap_set(heap, i, timer);
+}
+
+/*
+ * Move timer on position i of heap down, till heap property holds
+ */
+static void __gtkglut_timer_heap_down(GPtrArray * heap, int i)
+{
+	__gtkglut_timer_struct *timer;
+	__gtkglut_timer_struct *child;
+	int len;
+	int c;
+
+	len = heap->len;
+	timer = (__gtkglut_timer_struct *) g_ptr_array_index(heap, i);
+
+	while ((c = 2 * i + 1) < len) {
+		child = (__gtkglut_timer_struct *) g_ptr_array_index(heap, c);
+
+		if (c + 1 < len &&
+		    ((__gtkglut_timer_struct *) g_ptr_array_index(heap, c + 1))->expires <
+		    child->expires) {
+			c++;
+			child = (__gtkglut_timer_struct *) g_ptr_array_index(heap, c);
+		}
+
+		if (timer->expires <= child->expires)
+			break;
+
+		__gtkglut_timer_heap_set(heap, i, child);
+		i = c;
+	}
+
+	__gtkglut_timer_heap_set(heap, i, timer);
+}
+
+static void __gtkglut_timer_heap_insert(GPtrArray * heap, __gtkglut_timer_struct * timer)
+{
+
+	g_ptr_array_add(heap, timer);
+	__gtkglut_timer_heap_up(heap, heap->len - 1);
+}
+
+static void __gtkglut_timer_heap_remove(GPtrArray * heap, __gtkglut_timer_struct * timer)
+{
+	__gtkglut_timer_struct *last;
+	int i;
+
+	i = timer->heap_index;
+	last = (__gtkglut_timer_struct *) g_ptr_array_remove_index(heap, heap->len - 1);
+
+	if (last == timer)
+		return;
+
+	__gtkglut_timer_heap_set(heap, i, last);
+	__gtkglut_timer_heap_up(heap, i);
+	__gtkglut_timer_heap_down(heap, last->heap_index);
+}
+
+/*
+ * Run expired precise timers
+ */
+static void __gtkglut_timer_run_precise(__gtkglut_timer_wheel_struct * wheel)
+{
+	__gtkglut_timer_struct *timer;
+	gint64 now;
+
+	now = __gtkglut_timer_precise_now();
+
+	while (wheel->precise_heap->len > 0) {
+		timer = (__gtkglut_timer_struct *) g_ptr_array_index(wheel->precise_heap, 0);
+
+		if (timer->expires > now)
+			break;
+
+		__gtkglut_timer_heap_remove(wheel->precise_heap, timer);
+
+		timer->state = __GTKGLUT_TIMER_RUNNING;
+
+		timer->func(timer->value);
+
+		if (timer->state == __GTKGLUT_TIMER_RUNNING && timer->period > 0) {
+			timer->expires += timer->period;
+
+			if (timer->expires <= now)
+				timer->expires = now + timer->period;
+
+			timer->state = __GTKGLUT_TIMER_ARMED;
+			__gtkglut_timer_heap_insert(wheel->precise_heap, timer);
+		} else {
+			__gtkglut_timer_free(wheel, timer);
+		}
+	}
+}
+
+/*
+ * Compute poll timeout for nearest precise timer. Returns TRUE, if timer
+ * already expired.
+ */
+static gboolean __gtkglut_timer_precise_prepare(__gtkglut_timer_wheel_struct * wheel,
+						gint * timeout)
+{
+	__gtkglut_timer_struct *timer;
+	gint64 remaining;
+	gint precise_timeout;
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+	struct itimerspec its;
+#endif
+
+	timer = NULL;
+	remaining = 0;
+
+	if (wheel->precise_heap->len > 0) {
+		timer = (__gtkglut_timer_struct *) g_ptr_array_index(wheel->precise_heap, 0);
+
+		remaining = timer->expires - __gtkglut_timer_precise_now();
+
+		if (remaining <= 0)
+			return TRUE;
+	}
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+	if (wheel->precise_fd.fd >= 0) {
+		/*
+		 * Kernel wakes us up in time, so poll timeout is not affected
+		 */
+		if ((timer ? timer->expires : -1) != wheel->precise_fd_expires) {
+			memset(&its, 0, sizeof(its));
+
+			if (timer) {
+				its.it_value.tv_sec = timer->expires / 1000000;
+				its.it_value.tv_nsec = (timer->expires % 1000000) * 1000;
+			}
+
+			timerfd_settime(wheel->precise_fd.fd, TFD_TIMER_ABSTIME, &its, NULL);
+			wheel->precise_fd_expires = (timer ? timer->expires : -1);
+		}
+
+		return FALSE;
+	}
+#endif
+
+	if (timer) {
+		/*
+		 * Round down and poll without timeout rest of time
+		 */
+		precise_timeout = (gint) (remaining / 1000);
+
+		if (*timeout < 0 || precise_timeout < *timeout)
+			*timeout = precise_timeout;
+	}
+
+	return FALSE;
+}
+
+/*
+ * Return tick of nearest timer wheel event (timer expiration or cascade of
+ * nonempty slot). -1 is returned if there is no timer.
+ */
+static gint64 __gtkglut_timer_wheel_next_event(__gtkglut_timer_wheel_struct * wheel)
+{
+	__gtkglut_timer_struct *head;
+	gint64 next;
+	gint64 start;
+	gint64 unit;
+	gint64 tick;
+	int index;
+	int level;
+	int i;
+
+	if (wheel->no_timers == 0)
+		return -1;
+
+	/*
+	 * Cascade is done when wheel reaches tick with index 0
+	 */
+	if ((wheel->time & __GTKGLUT_TIMER_WHEEL_MASK) == 0)
+		return wheel->time;
+
+	next = -1;
+
+	/*
+	 * Every slot of level 0 holds timers of one of next 256 ticks
+	 */
+	if (wheel->level_count[0] > 0) {
+		for (tick = wheel->time; tick < wheel->time + __GTKGLUT_TIMER_WHEEL_SIZE; tick++) {
+			head = &wheel->slots[0][tick & __GTKGLUT_TIMER_WHEEL_MASK];
+
+			if (head->next != head) {
+				next = tick;
+				break;
+			}
+		}
+	}
+
+	/*
+	 * Slot of upper level is cascaded on tick with zero lower bits and level
+	 * index equal to slot. Cascaded timers never expire sooner than that, so
+	 * first nonempty slot of every level gives its nearest event.
+	 */
+	for (level = 1; level < __GTKGLUT_TIMER_WHEEL_LEVELS; level++) {
+		if (wheel->level_count[level] == 0)
+			continue;
+
+		unit = (gint64) 1 << (__GTKGLUT_TIMER_WHEEL_BITS * level);
+		start = (wheel->time + unit - 1) & ~(unit - 1);
+		index = (int)(start >> (__GTKGLUT_TIMER_WHEEL_BITS * level));
+
+		for (i = 0; i < __GTKGLUT_TIMER_WHEEL_SIZE; i++) {
+			head = &wheel->slots[level][(index + i) & __GTKGLUT_TIMER_WHEEL_MASK];
+
+			if (head->next != head) {
+				tick = start + i * unit;
+
+				if (next < 0 || tick < next)
+					next = tick;
+
+				break;
+			}
+		}
+	}
+
+	return next;
+}
+
+/*
+ * Run expired timers of one batch
+ */
+static void __gtkglut_timer_run_batch(__gtkglut_timer_wheel_struct * wheel,
+				      __gtkglut_timer_struct * batch, gint64 now)
+{
+	__gtkglut_timer_struct *timer;
+
+	while (batch->next != batch) {
+		timer = batch->next;
+
+		__gtkglut_timer_list_del(timer);
+		wheel->level_count[0]--;
+
+		timer->state = __GTKGLUT_TIMER_RUNNING;
+
+		timer->func(timer->value);
+
+		if (timer->state == __GTKGLUT_TIMER_RUNNING && timer->period > 0) {
+			/*
+			 * Periodic timer is scheduled from previous expiration, so it
+			 * doesn't drift. If we are late more then one period, skip missed
+			 * expirations.
+			 */
+			timer->expires += timer->period;
+
+			if (timer->expires <= now)
+				timer->expires = now + timer->period;
+
+			timer->state = __GTKGLUT_TIMER_ARMED;
+			__gtkglut_timer_wheel_insert(wheel, timer);
+		} else {
+			__gtkglut_timer_free(wheel, timer);
+		}
+	}
+}
+
+/*
+ * Advance wheel to tick now and run expired timers
+ */
+static void __gtkglut_timer_wheel_advance(__gtkglut_timer_wheel_struct * wheel, gint64 now)
+{
+	__gtkglut_timer_struct batch;
+	gint64 next;
+	int index;
+	int level;
+
+	while (wheel->time <= now) {
+		if (wheel->no_timers == 0) {
+			wheel->time = now + 1;
+			break;
+		}
+
+		index = wheel->time & __GTKGLUT_TIMER_WHEEL_MASK;
+
+		if (index == 0) {
+			for (level = 1; level < __GTKGLUT_TIMER_WHEEL_LEVELS; level++) {
+				index = (wheel->time >> (__GTKGLUT_TIMER_WHEEL_BITS * level)) &
+				    __GTKGLUT_TIMER_WHEEL_MASK;
+
+				__gtkglut_timer_wheel_cascade(wheel, level, index);
+
+				if (index != 0)
+					break;
+			}
+
+			index = 0;
+		}
+
+		if (wheel->level_count[0] == 0) {
+			/*
+			 * Nothing on level 0 -> skip to next cascade of nonempty slot
+			 */
+			wheel->time++;
+			next = __gtkglut_timer_wheel_next_event(wheel);
+			wheel->time = (next < 0 || next > now + 1) ? now + 1 : next;
+			continue;
+		}
+
+		__gtkglut_timer_list_move(&wheel->slots[0][index], &batch);
+
+		wheel->time++;
+
+		__gtkglut_timer_run_batch(wheel, &batch, now);
+	}
+}
+
+/*
+ * Timer source. It's ready, when nearest timer expired.
+ */
+static gboolean __gtkglut_timer_source_prepare(GSource * source, gint * timeout)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	gint64 next;
+	gint64 remaining;
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	*timeout = -1;
+
+	next = __gtkglut_timer_wheel_next_event(wheel);
+
+	if (next >= 0) {
+		remaining = wheel->base_time + next * 1000 - __gtkglut_get_time_usec();
+
+		if (remaining <= 0)
+			return TRUE;
+
+		*timeout = (gint) ((remaining + 999) / 1000);
+	}
+
+	return __gtkglut_timer_precise_prepare(wheel, timeout);
+}
+
+static gboolean __gtkglut_timer_source_check(GSource * source)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	gint timeout;
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+	guint64 expirations;
+#endif
+
+	wheel = __gtkglut_context->timer_wheel;
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+	if (wheel->precise_fd.fd >= 0 && (wheel->precise_fd.revents & G_IO_IN)) {
+		/*
+		 * Timerfd expired -> it's disarmed, read expirations so it's no
+		 * longer readable
+		 */
+		if (read(wheel->precise_fd.fd, &expirations, sizeof(expirations)) < 0) {
+			expirations = 0;
+		}
+
+		wheel->precise_fd_expires = -1;
+	}
+#endif
+
+	return __gtkglut_timer_source_prepare(source, &timeout);
+}
+
+static gboolean __gtkglut_timer_source_dispatch(GSource * source, GSourceFunc callback,
+						gpointer user_data)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	__gtkglut_timer_run_precise(wheel);
+
+	__gtkglut_timer_wheel_advance(wheel, __gtkglut_timer_now(wheel));
+
+	return TRUE;
+}
+
+static GSourceFuncs __gtkglut_timer_source_funcs = {
+	__gtkglut_timer_source_prepare,
+	__gtkglut_timer_source_check,
+	__gtkglut_timer_source_dispatch,
+	NULL
+};
+
+/*
+ * Create timer wheel and attach timer source. Source has same priority as
+ * g_timeout_add, which was used for timers before.
+ */
+static __gtkglut_timer_wheel_struct *__gtkglut_timer_wheel_new(void)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	int level;
+	int i;
+
+	wheel = (__gtkglut_timer_wheel_struct *) malloc(sizeof(__gtkglut_timer_wheel_struct));
+	if (!wheel)
+		__gtkglut_lowmem();
+
+	for (level = 0; level < __GTKGLUT_TIMER_WHEEL_LEVELS; level++) {
+		for (i = 0; i < __GTKGLUT_TIMER_WHEEL_SIZE; i++) {
+			__gtkglut_timer_list_init(&wheel->slots[level][i]);
+		}
+
+		wheel->level_count[level] = 0;
+	}
+
+	wheel->base_time = __gtkglut_get_time_usec();
+	wheel->time = 0;
+	wheel->no_timers = 0;
+	wheel->slabs = g_ptr_array_new();
+	wheel->free_list = NULL;
+	wheel->precise_heap = g_ptr_array_new();
+
+	wheel->source = g_source_new(&__gtkglut_timer_source_funcs, sizeof(GSource));
+	g_source_set_priority(wheel->source, G_PRIORITY_DEFAULT);
+
+	wheel->precise_fd.fd = -1;
+	wheel->precise_fd.events = G_IO_IN;
+	wheel->precise_fd.revents = 0;
+	wheel->precise_fd_expires = -1;
+
+#ifdef __GTKGLUT_HAVE_TIMERFD
+	wheel->precise_fd.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (wheel->precise_fd.fd >= 0) {
+		g_source_add_poll(wheel->source, &wheel->precise_fd);
+	}
+#endif
+
+	g_source_attach(wheel->source, NULL);
+
+	return wheel;
+}
+
+/*
+ * Arm new timer. First expiration is after msecs milliseconds, then every
+ * period milliseconds (period 0 means one shot timer). Return timer handle or
+ * 0 if timer cannot be created.
+ */
+int __gtkglut_timer_add(unsigned int msecs, unsigned int period, void (*func) (int value),
+			int value)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	__gtkglut_timer_struct *timer;
+	gint64 now;
+
+	if (!__gtkglut_context->timer_wheel) {
+		__gtkglut_context->timer_wheel = __gtkglut_timer_wheel_new();
+	}
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	timer = __gtkglut_timer_alloc(wheel);
+	if (!timer)
+		return 0;
+
+	now = __gtkglut_get_time_usec() - wheel->base_time;
+
+	/*
+	 * Round up, timer never expires sooner than requested
+	 */
+	timer->expires = (now + (gint64) msecs * 1000 + 999) / 1000;
+	timer->period = period;
+	timer->func = func;
+	timer->value = value;
+	timer->state = __GTKGLUT_TIMER_ARMED;
+
+	wheel->no_timers++;
+
+	if (wheel->time > __gtkglut_timer_now(wheel) + 1 || wheel->no_timers == 1) {
+		/*
+		 * Wheel was idle -> move it to current time
+		 */
+		wheel->time = __gtkglut_timer_now(wheel);
+	}
+
+	__gtkglut_timer_wheel_insert(wheel, timer);
+
+	return timer->handle;
+}
+
+/*
+ * Arm new precise timer. First expiration is after usecs microseconds, then
+ * every period microseconds. Return timer handle or 0 if timer cannot be
+ * created.
+ */
+int __gtkglut_timer_add_precise(gint64 usecs, gint64 period, void (*func) (int value),
+				int value)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	__gtkglut_timer_struct *timer;
+
+	if (!__gtkglut_context->timer_wheel) {
+		__gtkglut_context->timer_wheel = __gtkglut_timer_wheel_new();
+	}
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	timer = __gtkglut_timer_alloc(wheel);
+	if (!timer)
+		return 0;
+
+	timer->expires = __gtkglut_timer_precise_now() + usecs;
+	timer->period = period;
+	timer->func = func;
+	timer->value = value;
+	timer->level = __GTKGLUT_TIMER_PRECISE;
+	timer->state = __GTKGLUT_TIMER_ARMED;
+
+	__gtkglut_timer_heap_insert(wheel->precise_heap, timer);
+
+	return timer->handle;
+}
+
+/*
+ * Return microseconds till timer source needs to be dispatched (0 if it's
+ * already late) or -1 if there is no timer.
+ */
+gint64 __gtkglut_timer_next_wakeup(void)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	__gtkglut_timer_struct *timer;
+	gint64 next;
+	gint64 remaining;
+	gint64 res;
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	if (!wheel)
+		return -1;
+
+	res = -1;
+
+	next = __gtkglut_timer_wheel_next_event(wheel);
+
+	if (next >= 0) {
+		res = wheel->base_time + next * 1000 - __gtkglut_get_time_usec();
+
+		if (res < 0)
+			res = 0;
+	}
+
+	if (wheel->precise_heap->len > 0) {
+		timer = (__gtkglut_timer_struct *) g_ptr_array_index(wheel->precise_heap, 0);
+
+		remaining = timer->expires - __gtkglut_timer_precise_now();
+
+		if (remaining < 0)
+			remaining = 0;
+
+		if (res < 0 || remaining < res)
+			res = remaining;
+	}
+
+	return res;
+}
+
+/*
+ * Return TRUE, if precise timers wake up main loop by timerfd. Otherwise
+ * their last millisecond is spent by polling with zero timeout.
+ */
+gboolean __gtkglut_timer_precise_wakeup(void)
+{
+
+	if (!__gtkglut_context->timer_wheel) {
+		__gtkglut_context->timer_wheel = __gtkglut_timer_wheel_new();
+	}
+
+	return __gtkglut_context->timer_wheel->precise_fd.fd >= 0;
+}
+
+/*
+ * Cancel timer with handle. Return TRUE if timer was armed.
+ */
+gboolean __gtkglut_timer_cancel(int handle)
+{
+	__gtkglut_timer_wheel_struct *wheel;
+	__gtkglut_timer_struct *timer;
+
+	wheel = __gtkglut_context->timer_wheel;
+
+	if (!wheel || handle <= 0)
+		return FALSE;
+
+	timer = __gtkglut_timer_get_node(wheel, handle & __GTKGLUT_TIMER_INDEX_MASK);
+
+	if (!timer || timer->handle != handle)
+		return FALSE;
+
+	switch (timer->state) {
+	case __GTKGLUT_TIMER_ARMED:
+		if (timer->level == __GTKGLUT_TIMER_PRECISE) {
+			__gtkglut_timer_heap_remove(wheel->precise_heap, timer);
+		} else {
+			__gtkglut_timer_wheel_remove(wheel, timer);
+		}
+
+		__gtkglut_timer_free(wheel, timer);
+		return TRUE;
+		break;
+
+	case __GTKGLUT_TIMER_RUNNING:
+		/*
+		 * Cancelled from own callback -> freed after callback returns
+		 */
+		timer->state = __GTKGLUT_TIMER_CANCELLED;
+		return TRUE;
+		break;
+	}
+
+	return FALSE;
+}
+
+/*!
+ * \brief    Registers timer with handle.
+ * \ingroup  idletimer
+ * \param    msecs     Milliseconds till first invocation.
+ * \param    period    Milliseconds between next invocations, 0 for one shot timer.
+ * \param    func      Client function for timer event.
+ * \param    value     Arbitrary data; passed to \a func .
+ *
+ * Works like glutTimerFunc(), but returns handle, which can be
+ * used to cancel timer by glutCancelTimer().  If \a period is
+ * not 0, timer is periodic.  Periodic timer is scheduled relatively
+ * to its previous expiration, so it doesn't drift.  If application
+ * is late by more than \a period, missed invocations are skipped.
+ *
+ * Timers are kept in hierarchical timer wheel with millisecond
+ * resolution, so it's cheap to have many active timers and
+ * to arm and cancel them often.
+ *
+ * This callback is **not** bound to any window.
+ *
+ * \return   Timer handle (always positive) or 0 on error.
+ * \see glutTimerFunc(), glutCancelTimer()
+ */
+int glutAddTimer(unsigned int msecs, unsigned int period, void (*func) (int value), int value)
+{
+	int res;
+
+	__gtkglut_test_inicialization("glutAddTimer");
+
+	if (func == NULL) {
+		__gtkglut_warning("glutAddTimer", "Registering NULL callback doesn't make sense.");
+
+		return 0;
+	}
+
+	res = __gtkglut_timer_add(msecs, period, func, value);
+
+	if (!res) {
+		__gtkglut_warning("glutAddTimer", "Too many active timers.");
+	}
+
+	return res;
+}
+
+/*!
+ * \brief    Registers timer with microsecond resolution.
+ * \ingroup  idletimer
+ * \param    usecs     Microseconds till first invocation.
+ * \param    period    Microseconds between next invocations, 0 for one shot timer.
+ * \param    func      Client function for timer event.
+ * \param    value     Arbitrary data; passed to \a func .
+ *
+ * Works like glutAddTimer(), but times are in microseconds.  On
+ * Linux, main loop is woken up by timerfd, so timer fires with
+ * sub-millisecond accuracy.  On other systems, last millisecond
+ * before expiration is spent by busy polling, so use this timer
+ * only when precision really matters.
+ *
+ * Returned handle can be cancelled by glutCancelTimer().
+ *
+ * \return   Timer handle (always positive) or 0 on error.
+ * \see glutAddTimer(), glutCancelTimer(), glutGet64()
+ */
+int glutAddTimerUsec(GLUTint64 usecs, GLUTint64 period, void (*func) (int value), int value)
+{
+	int res;
+
+	__gtkglut_test_inicialization("glutAddTimerUsec");
+
+	if (func == NULL) {
+		__gtkglut_warning("glutAddTimerUsec",
+				  "Registering NULL callback doesn't make sense.");
+
+		return 0;
+	}
+
+	if (usecs < 0)
+		usecs = 0;
+
+	if (period < 0)
+		period = 0;
+
+	res = __gtkglut_timer_add_precise(usecs, period, func, value);
+
+	if (!res) {
+		__gtkglut_warning("glutAddTimerUsec", "Too many active timers.");
+	}
+
+	return res;
+}
+
+/*!
+ * \brief    Cancels timer.
+ * \ingroup  idletimer
+ * \param    timer    Handle returned by glutAddTimer() or glutAddTimerUsec().
+ *
+ * Timer callback will not be called anymore.  Timer can be
+ * also cancelled from its own callback.  Handle of expired
+ * one shot timer is invalid, so cancelling such timer is
+ * harmless.
+ *
+ * \see glutAddTimer(), glutAddTimerUsec()
+ */
+void glutCancelTimer(int timer)
+{
+	__gtkglut_test_inicialization("glutCancelTimer");
+
+	__gtkglut_timer_cancel(timer);
+}
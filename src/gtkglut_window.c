@@ -35,6 +35,14 @@
 #include "GL/gtkglut.h"
 #include "gtkglut_internal.h"
 
+#ifdef GDK_WINDOWING_X11
+#include <gdk/gdkglx.h>
+#endif
+
+#ifdef GDK_WINDOWING_WIN32
+#include <gdk/gdkglwin32.h>
+#endif
+
 /*
  * Create GTK drawing area with OpenGL context asociated
  */
@@ -44,11 +52,29 @@ GtkWidget *__gtkglut_create_drawing_area(char *func_name)
 	gboolean direct_render;
 	gboolean res;
 	gboolean is_rgba;
+	GdkGLContext *share_list;
+	__gtkglut_window_struct *current_glut_window;
 
 	if (__gtkglut_context->actual_gl_config == NULL) {
 		__gtkglut_error(func_name, "No appropriate OpenGL-capable visual found.");
 	}
 
+	share_list = NULL;
+
+	if (__gtkglut_context->rendering_context == GLUT_USE_CURRENT_CONTEXT) {
+		/*
+		 * Share object namespace with current window
+		 */
+		current_glut_window = __gtkglut_get_window_by_id(__gtkglut_context->current_window);
+
+		if (current_glut_window && GTK_WIDGET_REALIZED(current_glut_window->drawing_area))
+			share_list = gtk_widget_get_gl_context(current_glut_window->drawing_area);
+
+		if (!share_list)
+			__gtkglut_warning(func_name,
+					  "no current window to share OpenGL context with");
+	}
+
 	drawing_area = gtk_drawing_area_new();
 
 	direct_render =
@@ -57,7 +83,7 @@ GtkWidget *__gtkglut_create_drawing_area(char *func_name)
 	is_rgba = gdk_gl_config_is_rgba(__gtkglut_context->actual_gl_config);
 
 	res = gtk_widget_set_gl_capability(drawing_area, __gtkglut_context->actual_gl_config,
-					   NULL, direct_render,
+					   share_list, direct_render,
 					   is_rgba ? GDK_GL_RGBA_TYPE : GDK_GL_COLOR_INDEX_TYPE);
 
 	if (!res) {
@@ -66,7 +92,7 @@ GtkWidget *__gtkglut_create_drawing_area(char *func_name)
 		 */
 		res =
 		    gtk_widget_set_gl_capability(drawing_area, __gtkglut_context->actual_gl_config,
-						 NULL, FALSE,
+						 share_list, FALSE,
 						 is_rgba ? GDK_GL_RGBA_TYPE :
 						 GDK_GL_COLOR_INDEX_TYPE);
 
@@ -80,7 +106,7 @@ GtkWidget *__gtkglut_create_drawing_area(char *func_name)
 	 */
 	GTK_WIDGET_SET_FLAGS(drawing_area, GTK_CAN_FOCUS);
 
-	gtk_widget_add_events(drawing_area, GDK_ENTER_NOTIFY_MASK);
+	gtk_widget_add_events(drawing_area, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK);
 
 	return drawing_area;
 }
@@ -107,14 +133,9 @@ void __gtkglut_test_direct_rendering(char *func_name, GtkWidget * drawing_area)
 
 __gtkglut_window_struct *__gtkglut_get_window_by_id(int window_id)
 {
-	if (window_id < 0 || !__gtkglut_context->window_array
-	    || (guint) window_id >= __gtkglut_context->window_array->len) {
-/*    __gtkglut_error("__gtkglut_get_window_by_id","Internal error. Access window %d, which doesn't exists!",window_id);*/
-		return NULL;
-	}
-
-	return (__gtkglut_window_struct *) g_ptr_array_index(__gtkglut_context->window_array,
-							     window_id);
+	return (__gtkglut_window_struct *) __gtkglut_id_table_get(__gtkglut_context->window_array,
+								  __gtkglut_context->window_ids,
+								  window_id);
 }
 
 /*!
@@ -225,7 +246,8 @@ void glutSetWindow(int win)
 
 	__gtkglut_test_inicialization("glutSetWindow");
 
-	if (win < 1 || (guint) win >= __gtkglut_context->window_array->len) {
+	if (win < 1 || !__gtkglut_context->window_array
+	    || (guint) __GTKGLUT_ID_SLOT(win) >= __gtkglut_context->window_array->len) {
 		__gtkglut_warning("glutSetWindow", "Attempted on bogus window %d!", win);
 		return;
 	}
@@ -243,15 +265,29 @@ void glutSetWindow(int win)
 
 	drawing_area = glut_window->drawing_area;
 
+	gl_context = gtk_widget_get_gl_context(drawing_area);
+	gl_drawable = gtk_widget_get_gl_drawable(drawing_area);
+
+	if (gl_drawable && gl_drawable == __gtkglut_context->current_gl_drawable &&
+	    gl_context == __gtkglut_context->current_gl_context) {
+		/*
+		 * Already current -> nothing to do
+		 */
+		return;
+	}
+
 	if (__gtkglut_context->current_gl_drawable) {
 		gdk_gl_drawable_gl_end(__gtkglut_context->current_gl_drawable);
 	}
 
-	gl_context = gtk_widget_get_gl_context(drawing_area);
-	gl_drawable = gtk_widget_get_gl_drawable(drawing_area);
+	__gtkglut_context->gl_context_switches++;
 
 	if (!gdk_gl_drawable_gl_begin(gl_drawable, gl_context)) {
 		__gtkglut_warning("glutSetWindow", "Can't begin draw on GL %d!", win);
+
+		__gtkglut_context->current_gl_drawable = NULL;
+		__gtkglut_context->current_gl_context = NULL;
+
 		return;
 	}
 
@@ -291,6 +327,39 @@ int glutGetWindow(void)
 	return res;
 }
 
+/*
+ * Release GL objects of window (meshes and instancing program of its GL context,
+ * frame fences, timer queries of frame statistics), when window is going to be
+ * destroyed. GL objects can be deleted only in their GL context, so context of
+ * window is made current. If it can't be, objects are only forgotten.
+ */
+static void __gtkglut_window_gl_cleanup(int win, __gtkglut_window_struct * glut_window)
+{
+	GdkGLContext *gl_context;
+	gboolean in_context;
+	int current_window;
+
+	current_window = __gtkglut_context->current_window;
+	in_context = FALSE;
+
+	if (GTK_WIDGET_REALIZED(glut_window->drawing_area)) {
+		gl_context = gtk_widget_get_gl_context(glut_window->drawing_area);
+
+		if (current_window != win)
+			glutSetWindow(win);
+
+		in_context = (__gtkglut_context->current_gl_context == gl_context);
+
+		__gtkglut_mesh_cache_purge(gl_context, in_context);
+	}
+
+	__gtkglut_frame_fences_delete(glut_window, in_context);
+	__gtkglut_frame_stats_free(glut_window, in_context);
+
+	if (current_window && current_window != win)
+		glutSetWindow(current_window);
+}
+
 /*
  * Destroy gtkglut window with id win, and all childs. GTK window is not destroyed!
  */
@@ -305,6 +374,8 @@ void __gtkglut_destroy_glut_window(int win)
 		__gtkglut_error("internal error", "trying destroy nonexistent window %d", win);
 	}
 
+	__gtkglut_window_gl_cleanup(win, glut_window);
+
 	if (glutGetWindow() == win) {
 		/*
 		 * if we destroy window in use -> change gl context,drawable
@@ -314,7 +385,19 @@ void __gtkglut_destroy_glut_window(int win)
 		__gtkglut_context->current_gl_context = NULL;
 	}
 
-	g_ptr_array_index(__gtkglut_context->window_array, win) = NULL;
+	if (GTK_WIDGET_REALIZED(glut_window->drawing_area) &&
+	    gtk_widget_get_gl_drawable(glut_window->drawing_area) ==
+	    __gtkglut_context->current_gl_drawable) {
+		/*
+		 * Bound drawable goes away even if current window id is other (or bogus)
+		 * one. New drawable at same address mustn't look already current.
+		 */
+		__gtkglut_context->current_gl_drawable = NULL;
+		__gtkglut_context->current_gl_context = NULL;
+	}
+
+	__gtkglut_id_table_remove(__gtkglut_context->window_array,
+				  __gtkglut_context->window_free_slots, win);
 
 	if (glut_window->child_list) {
 		elem = glut_window->child_list;
@@ -333,6 +416,10 @@ void __gtkglut_destroy_glut_window(int win)
 		g_slist_free(glut_window->child_list);
 	}
 
+	if (glut_window->motion_history) {
+		g_array_free(glut_window->motion_history, TRUE);
+	}
+
 	free(glut_window);
 }
 
@@ -404,10 +491,13 @@ void __gtkglut_destroy_all_windows(void)
 	__gtkglut_test_inicialization("__gtkglut_destroy_all_windows");
 
 	for (i = 0; i < __gtkglut_context->window_array->len; i++) {
-		glut_window = __gtkglut_get_window_by_id(i);
+		glut_window = (__gtkglut_window_struct *)
+		    g_ptr_array_index(__gtkglut_context->window_array, i);
 
 		if (glut_window) {
-			__gtkglut_destroy_window("__gtkglut_destroy_all_windows", i);
+			__gtkglut_destroy_window("__gtkglut_destroy_all_windows",
+						 __gtkglut_id_table_slot_id(__gtkglut_context->
+									    window_ids, i));
 		}
 	}
 }
@@ -423,9 +513,11 @@ void __gtkglut_destroy_all_windows(void)
  *
  * Once a window has been destroyed, further attempts to
  * use the window named by \a win are undefined.  GtkGLUT generally
- * tries to be sensible, and should not recycle the dead
- * \a win, but you should treat a destroyed window much
- * like a pointer to deallocated memory and try not to use it.
+ * tries to be sensible.  Internal slot of dead window is reused,
+ * but with new generation in \a win, so dead \a win is rejected
+ * (until generation wraps after 32768 reuses of same slot).  You
+ * should still treat a destroyed window much like a pointer to
+ * deallocated memory and try not to use it.
  *
  * \see glutCreateWindow()
  */
@@ -470,23 +562,20 @@ __gtkglut_window_struct *__gtkglut_get_active_window_with_warning(char *func_nam
 }
 
 /*
- * Append window glut_window to global windows array
+ * Add window glut_window to global windows array. Returns window id.
  */
-void __gtkglut_window_array_append(__gtkglut_window_struct * glut_window)
+int __gtkglut_window_array_append(__gtkglut_window_struct * glut_window)
 {
-	if (!__gtkglut_context->window_array) {
-		__gtkglut_context->window_array = g_ptr_array_new();
+	int window_id;
 
-		if (!__gtkglut_context->window_array)
-			__gtkglut_lowmem();
+	window_id = __gtkglut_id_table_add(&__gtkglut_context->window_array,
+					   &__gtkglut_context->window_ids,
+					   &__gtkglut_context->window_free_slots, glut_window);
 
-		/*
-		 * Because GLUT start numbering from 1, we do this same way
-		 */
-		g_ptr_array_add(__gtkglut_context->window_array, NULL);
-	}
+	if (!window_id)
+		__gtkglut_error("__gtkglut_window_array_append", "too many windows");
 
-	g_ptr_array_add(__gtkglut_context->window_array, glut_window);
+	return window_id;
 }
 
 /*
@@ -526,20 +615,148 @@ void __gtkglut_callback_reshape_call(__gtkglut_window_struct * glut_window, int
 }
 
 /*
- * GTK+ expose handler for drawingarea
+ * Return TRUE, if window is hidden, iconified or fully covered. Window with
+ * unknown visibility is not hidden.
  */
-static gboolean __gtkglut_callback_expose_handler(GtkWidget * widget, GdkEventExpose * event,
-						  gpointer data)
+static gboolean __gtkglut_window_is_hidden(__gtkglut_window_struct * glut_window)
 {
-	int width;
-	int height;
+
+	return glut_window->iconified || glut_window->window_visible == FALSE;
+}
+
+/*
+ * Enable or disable skipping of redisplay of hidden windows
+ */
+void __gtkglut_set_skip_hidden_redisplay(int value)
+{
+	__gtkglut_window_struct *glut_window;
 	int window_id;
+	guint i;
+
+	__gtkglut_context->skip_hidden_redisplay = (value != 0);
+
+	if (!__gtkglut_context->window_array)
+		return;
+
+	for (i = 0; i < __gtkglut_context->window_array->len; i++) {
+		glut_window = (__gtkglut_window_struct *)
+		    g_ptr_array_index(__gtkglut_context->window_array, i);
+
+		if (!glut_window)
+			continue;
+
+		if (__gtkglut_context->skip_hidden_redisplay
+		    && !glut_window->event_table[GDK_VISIBILITY_NOTIFY]) {
+			/*
+			 * We don't know, if window is covered, until first visibility event
+			 */
+			glut_window->window_visible = __GTKGLUT_UNDEFINED;
+		}
+
+		window_id = __gtkglut_id_table_slot_id(__gtkglut_context->window_ids, i);
+
+		__gtkglut_window_events_update(glut_window, window_id);
+
+		if (!__gtkglut_context->skip_hidden_redisplay && glut_window->redisplay_deferred) {
+			glut_window->redisplay_deferred = FALSE;
+			__gtkglut_queue_window_redisplay(glut_window, window_id);
+		}
+	}
+}
+
+/*
+ * Enable or disable pointer cache. Motion events of windows with keyboard
+ * callbacks are tracked as needed.
+ */
+void __gtkglut_set_pointer_cache(int value)
+{
 	__gtkglut_window_struct *glut_window;
+	guint i;
 
-	window_id = GPOINTER_TO_INT(data);
+	__gtkglut_context->pointer_cache = (value != 0);
+
+	if (!__gtkglut_context->window_array)
+		return;
+
+	for (i = 0; i < __gtkglut_context->window_array->len; i++) {
+		glut_window = (__gtkglut_window_struct *)
+		    g_ptr_array_index(__gtkglut_context->window_array, i);
+
+		if (glut_window)
+			__gtkglut_window_events_update(glut_window,
+						       __gtkglut_id_table_slot_id(__gtkglut_context->
+										  window_ids, i));
+	}
+}
+
+/*
+ * Enable or disable event dispatcher. GTK+ signals of windows are connected
+ * or disconnected.
+ */
+void __gtkglut_set_event_dispatch(int value)
+{
+	__gtkglut_window_struct *glut_window;
+	guint i;
+
+	__gtkglut_context->event_dispatch = (value != 0);
+
+	if (!__gtkglut_context->window_array)
+		return;
+
+	for (i = 0; i < __gtkglut_context->window_array->len; i++) {
+		glut_window = (__gtkglut_window_struct *)
+		    g_ptr_array_index(__gtkglut_context->window_array, i);
+
+		if (glut_window)
+			__gtkglut_window_events_update(glut_window,
+						       __gtkglut_id_table_slot_id(__gtkglut_context->
+										  window_ids, i));
+	}
+}
+
+/*
+ * Remember pointer position of window for keyboard callbacks
+ */
+static void __gtkglut_cache_pointer(__gtkglut_window_struct * glut_window, gdouble x, gdouble y)
+{
+	glut_window->pointer_x = (int)x;
+	glut_window->pointer_y = (int)y;
+	glut_window->pointer_valid = TRUE;
+}
+
+/*
+ * Execute pending redisplay of window. Called from redisplay source, so
+ * window may be already destroyed or unmapped.
+ */
+void __gtkglut_display_window(int window_id)
+{
+	int width;
+	int height;
+	__gtkglut_window_struct *glut_window;
 
 	glut_window = __gtkglut_get_window_by_id(window_id);
 
+	if (!glut_window || !glut_window->redisplay_pending)
+		return;
+
+	glut_window->redisplay_pending = FALSE;
+
+	if (!gdk_window_is_viewable(glut_window->drawing_area->window)) {
+		/*
+		 * Window will get expose after map
+		 */
+		return;
+	}
+
+	if (__gtkglut_context->skip_hidden_redisplay && __gtkglut_window_is_hidden(glut_window)) {
+		/*
+		 * Catch up, when window become visible
+		 */
+		glut_window->redisplay_deferred = TRUE;
+
+		return;
+	}
+
 	if (!glut_window->callback_display) {
 		__gtkglut_error("glut display callback",
 				"You don't set display callback for window %d", window_id);
@@ -548,8 +765,8 @@ static gboolean __gtkglut_callback_expose_handler(GtkWidget * widget, GdkEventEx
 	if (!glut_window->first_displayed) {
 		glut_window->first_displayed = TRUE;
 
-		width = widget->allocation.width;
-		height = widget->allocation.height;
+		width = glut_window->drawing_area->allocation.width;
+		height = glut_window->drawing_area->allocation.height;
 
 		glutSetWindow(window_id);
 
@@ -558,11 +775,30 @@ static gboolean __gtkglut_callback_expose_handler(GtkWidget * widget, GdkEventEx
 
 	glutSetWindow(window_id);
 
-	glut_window->callback_display();
+	if (__gtkglut_context->frame_stats) {
+		__gtkglut_frame_stats_begin(glut_window);
+		glut_window->callback_display();
+		__gtkglut_frame_stats_end(glut_window, window_id);
+	} else {
+		glut_window->callback_display();
+	}
 
 	__gtkglut_gl_debug();
 
 	glut_window->damaged = FALSE;
+}
+
+/*
+ * GTK+ expose handler for drawingarea. Expose is merged with posted redisplays.
+ */
+static gboolean __gtkglut_callback_expose_handler(GtkWidget * widget, GdkEventExpose * event,
+						  gpointer data)
+{
+	int window_id;
+
+	window_id = GPOINTER_TO_INT(data);
+
+	__gtkglut_queue_window_redisplay(__gtkglut_get_window_by_id(window_id), window_id);
 
 	return TRUE;
 }
@@ -583,11 +819,59 @@ void __gtkglut_callback_reshape_handler(GtkWidget * widget, GtkAllocation * allo
 	window_id = GPOINTER_TO_INT(data);
 	glut_window = __gtkglut_get_window_by_id(window_id);
 
+	glut_window->geometry.width = width;
+	glut_window->geometry.height = height;
+	glut_window->geometry_size_valid = TRUE;
+
 	glutSetWindow(window_id);
 
 	__gtkglut_callback_reshape_call(glut_window, width, height);
 }
 
+/*
+ * Store position of window and all its childs to geometry cache
+ */
+void __gtkglut_cache_window_position(__gtkglut_window_struct * glut_window, int x, int y)
+{
+	GSList *elem;
+	__gtkglut_window_struct *child;
+
+	glut_window->geometry.x = x;
+	glut_window->geometry.y = y;
+	glut_window->geometry_position_valid = TRUE;
+
+	for (elem = glut_window->child_list; elem; elem = g_slist_next(elem)) {
+		child = __gtkglut_get_window_by_id(GPOINTER_TO_INT(elem->data));
+
+		if (child)
+			__gtkglut_cache_window_position(child, x, y);
+	}
+}
+
+/*
+ * GTK+ event handler for toplevel window, if its position or size changes.
+ * Position of window is queried only here, not in every glutGet.
+ */
+gboolean __gtkglut_toplevel_configure_event(GtkWidget * widget, GdkEventConfigure * event,
+					    gpointer data)
+{
+	int x, y;
+	__gtkglut_window_struct *glut_window;
+
+	glut_window = __gtkglut_get_window_by_id(GPOINTER_TO_INT(data));
+
+	if (glut_window && widget->window) {
+		gdk_window_get_root_origin(widget->window, &x, &y);
+
+		__gtkglut_cache_window_position(glut_window, x, y);
+	}
+
+	/*
+	 * GtkWindow must handle event too
+	 */
+	return FALSE;
+}
+
 /*
  * Change window visibility status and call asociated function
  */
@@ -647,6 +931,11 @@ void __gtkglut_change_window_status(int window_id, gboolean visible, int status,
 			__gtkglut_gl_debug();
 		}
 
+		if (glut_window->redisplay_deferred && !__gtkglut_window_is_hidden(glut_window)) {
+			glut_window->redisplay_deferred = FALSE;
+			__gtkglut_queue_window_redisplay(glut_window, window_id);
+		}
+
 		if (recurse && glut_window->child_list) {
 			elem = glut_window->child_list;
 			while (elem) {
@@ -683,23 +972,26 @@ gboolean __gtkglut_window_state_handler(GtkWidget * widget, GdkEventWindowState
 	}
 
 	if (event->changed_mask & GDK_WINDOW_STATE_ICONIFIED) {
-		__gtkglut_change_window_status(window_id,
-					       !(event->
-						 new_window_state & GDK_WINDOW_STATE_ICONIFIED),
-					       (event->
-						new_window_state & GDK_WINDOW_STATE_ICONIFIED) ?
-					       GLUT_HIDDEN : __GTKGLUT_UNDEFINED, TRUE);
-
 		glut_window = __gtkglut_get_window_by_id(window_id);
 
 		if (!glut_window) {
 			__gtkglut_warning("__gtkglut_window_state_handler",
 					  "Internal error. Attempt on bogus window %d", window_id);
 		} else {
+			/*
+			 * Set before status change, so callbacks and deferred redisplay
+			 * see new state
+			 */
 			glut_window->iconified =
 			    (event->new_window_state & GDK_WINDOW_STATE_ICONIFIED) ? TRUE : FALSE;
 		}
 
+		__gtkglut_change_window_status(window_id,
+					       !(event->
+						 new_window_state & GDK_WINDOW_STATE_ICONIFIED),
+					       (event->
+						new_window_state & GDK_WINDOW_STATE_ICONIFIED) ?
+					       GLUT_HIDDEN : __GTKGLUT_UNDEFINED, TRUE);
 	}
 	return TRUE;
 }
@@ -780,6 +1072,169 @@ gboolean __gtkglut_toplevel_window_delete_event(GtkWidget * widget, GdkEvent * e
 	return TRUE;
 }
 
+/*
+ * Key table flags. Low byte of entry is character or special key code.
+ */
+#define __GTKGLUT_KEY_ASCII	0x100
+#define __GTKGLUT_KEY_SPECIAL	0x200
+
+/*
+ * Translation of 0xFF00 - 0xFFFF keysym page (function, cursor, keypad
+ * and modifier keys), indexed by low byte of keysym
+ */
+static guint16 __gtkglut_keysym_page_ff[256];
+
+static const struct {
+	guint keyval;
+	guint16 entry;
+} __gtkglut_keysym_list[] = {
+	{GDK_BackSpace, __GTKGLUT_KEY_ASCII | 8},
+	{GDK_Tab, __GTKGLUT_KEY_ASCII | 9},
+	{GDK_Linefeed, __GTKGLUT_KEY_ASCII | 10},
+	{GDK_Return, __GTKGLUT_KEY_ASCII | 13},
+	{GDK_Escape, __GTKGLUT_KEY_ASCII | 27},
+	{GDK_Delete, __GTKGLUT_KEY_ASCII | 127},
+	{GDK_KP_Space, __GTKGLUT_KEY_ASCII | ' '},
+	{GDK_KP_Tab, __GTKGLUT_KEY_ASCII | 9},
+	{GDK_KP_Enter, __GTKGLUT_KEY_ASCII | 13},
+	{GDK_KP_Delete, __GTKGLUT_KEY_ASCII | 127},
+	{GDK_KP_Equal, __GTKGLUT_KEY_ASCII | '='},
+	{GDK_KP_Multiply, __GTKGLUT_KEY_ASCII | '*'},
+	{GDK_KP_Add, __GTKGLUT_KEY_ASCII | '+'},
+	{GDK_KP_Separator, __GTKGLUT_KEY_ASCII | ','},
+	{GDK_KP_Subtract, __GTKGLUT_KEY_ASCII | '-'},
+	{GDK_KP_Decimal, __GTKGLUT_KEY_ASCII | '.'},
+	{GDK_KP_Divide, __GTKGLUT_KEY_ASCII | '/'},
+	{GDK_KP_0, __GTKGLUT_KEY_ASCII | '0'},
+	{GDK_KP_1, __GTKGLUT_KEY_ASCII | '1'},
+	{GDK_KP_2, __GTKGLUT_KEY_ASCII | '2'},
+	{GDK_KP_3, __GTKGLUT_KEY_ASCII | '3'},
+	{GDK_KP_4, __GTKGLUT_KEY_ASCII | '4'},
+	{GDK_KP_5, __GTKGLUT_KEY_ASCII | '5'},
+	{GDK_KP_6, __GTKGLUT_KEY_ASCII | '6'},
+	{GDK_KP_7, __GTKGLUT_KEY_ASCII | '7'},
+	{GDK_KP_8, __GTKGLUT_KEY_ASCII | '8'},
+	{GDK_KP_9, __GTKGLUT_KEY_ASCII | '9'},
+	{GDK_F1, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F1},
+	{GDK_F2, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F2},
+	{GDK_F3, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F3},
+	{GDK_F4, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F4},
+	{GDK_F5, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F5},
+	{GDK_F6, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F6},
+	{GDK_F7, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F7},
+	{GDK_F8, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F8},
+	{GDK_F9, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F9},
+	{GDK_F10, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F10},
+	{GDK_F11, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F11},
+	{GDK_F12, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F12},
+	{GDK_KP_F1, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F1},
+	{GDK_KP_F2, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F2},
+	{GDK_KP_F3, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F3},
+	{GDK_KP_F4, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_F4},
+	{GDK_Left, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_LEFT},
+	{GDK_Up, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_UP},
+	{GDK_Right, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_RIGHT},
+	{GDK_Down, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_DOWN},
+	{GDK_Prior, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_PAGE_UP},
+	{GDK_Next, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_PAGE_DOWN},
+	{GDK_Home, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_HOME},
+	{GDK_End, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_END},
+	{GDK_Begin, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_BEGIN},
+	{GDK_Insert, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_INSERT},
+	{GDK_KP_Left, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_LEFT},
+	{GDK_KP_Up, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_UP},
+	{GDK_KP_Right, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_RIGHT},
+	{GDK_KP_Down, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_DOWN},
+	{GDK_KP_Prior, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_PAGE_UP},
+	{GDK_KP_Next, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_PAGE_DOWN},
+	{GDK_KP_Home, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_HOME},
+	{GDK_KP_End, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_END},
+	{GDK_KP_Begin, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_BEGIN},
+	{GDK_KP_Insert, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_INSERT},
+	{GDK_Num_Lock, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_NUM_LOCK},
+	{GDK_Shift_L, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_SHIFT_L},
+	{GDK_Shift_R, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_SHIFT_R},
+	{GDK_Control_L, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_CTRL_L},
+	{GDK_Control_R, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_CTRL_R},
+	{GDK_Alt_L, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_ALT_L},
+	{GDK_Alt_R, __GTKGLUT_KEY_SPECIAL | GLUT_KEY_ALT_R},
+};
+
+/*
+ * Fill keysym translation table. Called once from context init.
+ */
+void __gtkglut_keysym_table_init(void)
+{
+	guint i;
+
+	for (i = 0; i < sizeof(__gtkglut_keysym_list) / sizeof(__gtkglut_keysym_list[0]); i++) {
+		__gtkglut_keysym_page_ff[__gtkglut_keysym_list[i].keyval & 0xFF] =
+		    __gtkglut_keysym_list[i].entry;
+	}
+}
+
+/*
+ * Translate keysym to GLUT key. Returns __GTKGLUT_KEY_ASCII with character in key,
+ * __GTKGLUT_KEY_SPECIAL with special key code in key or 0 for unknown keysym.
+ * Control modifies ASCII characters same way as XLookupString does.
+ */
+static int __gtkglut_translate_keysym(guint keyval, guint state, int *key)
+{
+	guint16 entry;
+	gunichar uc;
+	int c;
+
+	if (keyval >= 0x20 && keyval <= 0xFF) {
+		/*
+		 * Latin-1 keysyms are equal to characters
+		 */
+		c = keyval;
+
+		if (state & GDK_CONTROL_MASK) {
+			if ((c >= '@' && c < 0x7F) || c == ' ')
+				c &= 0x1F;
+			else if (c == '2')
+				c = 0;
+			else if (c >= '3' && c <= '7')
+				c -= '3' - 0x1B;
+			else if (c == '8')
+				c = 0x7F;
+			else if (c == '/')
+				c = '_' & 0x1F;
+		}
+
+		*key = c;
+
+		return __GTKGLUT_KEY_ASCII;
+	}
+
+	if ((keyval & 0xFFFFFF00) == 0xFF00) {
+		entry = __gtkglut_keysym_page_ff[keyval & 0xFF];
+
+		*key = entry & 0xFF;
+
+		return entry & (__GTKGLUT_KEY_ASCII | __GTKGLUT_KEY_SPECIAL);
+	}
+
+	if (keyval == GDK_ISO_Left_Tab) {
+		*key = 9;
+
+		return __GTKGLUT_KEY_ASCII;
+	}
+
+	/*
+	 * Rare keysyms, which still map to Latin-1 character
+	 */
+	uc = gdk_keyval_to_unicode(keyval);
+	if (uc > 0 && uc <= 0xFF) {
+		*key = uc;
+
+		return __GTKGLUT_KEY_ASCII;
+	}
+
+	return 0;
+}
+
 /*
  * GTK+ key handler
  */
@@ -790,14 +1245,8 @@ gboolean __gtkglut_callback_key_handler(GtkWidget * widget, GdkEventKey * event,
 	void (*keyboard_func) (unsigned char key, int x, int y);
 	__gtkglut_window_struct *glut_window;
 	gint mouse_x, mouse_y;
-	int special_key;
-	/*
-	 * GTK event->string handles almost everything but ... there is
-	 * problem with Tab, Delete and Backspace key.
-	 * This variable hold 0 if user didn't press this keys, otherwise code
-	 * for Tab, Delete or Backspace.
-	 */
-	char tbd_key;
+	int key_type;
+	int key;
 
 	window_id = GPOINTER_TO_INT(data);
 
@@ -823,140 +1272,31 @@ gboolean __gtkglut_callback_key_handler(GtkWidget * widget, GdkEventKey * event,
 			     signal_keyboard_up.glut_callback_handler);
 		}
 
-		if (keyboard_func || special_func) {
-			gdk_window_get_pointer(glut_window->drawing_area->window, &mouse_x,
-					       &mouse_y, NULL);
+		key_type = __gtkglut_translate_keysym(event->keyval, event->state, &key);
 
-			tbd_key = 0;
-
-			if (event->length <= 0) {
+		if ((key_type == __GTKGLUT_KEY_ASCII && keyboard_func) ||
+		    (key_type == __GTKGLUT_KEY_SPECIAL && special_func)) {
+			if (__gtkglut_context->pointer_cache && glut_window->pointer_valid
+			    && glut_window->event_table[GDK_MOTION_NOTIFY]) {
 				/*
-				 * Handle tbd key
+				 * Pointer is inside window and every motion is tracked
 				 */
-				switch (event->keyval) {
-				case GDK_Delete:
-				case GDK_KP_Delete:
-					tbd_key = 127;
-					break;
-				case GDK_Tab:
-				case GDK_KP_Tab:
-					tbd_key = 9;
-					break;
-				case GDK_BackSpace:
-					tbd_key = 8;
-					break;
-				}
+				mouse_x = glut_window->pointer_x;
+				mouse_y = glut_window->pointer_y;
+			} else {
+				gdk_window_get_pointer(glut_window->drawing_area->window, &mouse_x,
+						       &mouse_y, NULL);
 			}
 
-			/*
-			 * We use deprecated code, but this is only possibility how to do this
-			 */
-			if (event->length > 0 || tbd_key) {
-				if (keyboard_func) {
-					__gtkglut_context->keyboard_modifiers = event->state;
-					glutSetWindow(window_id);
-
-					if (tbd_key)
-						keyboard_func(tbd_key, mouse_x, mouse_y);
-					else
-						keyboard_func(event->string[0], mouse_x, mouse_y);
+			__gtkglut_context->keyboard_modifiers = event->state;
+			glutSetWindow(window_id);
 
-					__gtkglut_context->keyboard_modifiers = __GTKGLUT_UNDEFINED;
-				}
-			} else {
-				/*
-				 * Special code
-				 */
-				special_key = -1;
-
-				switch (event->keyval) {
-				case GDK_F1:
-				case GDK_KP_F1:
-					special_key = GLUT_KEY_F1;
-					break;
-				case GDK_F2:
-				case GDK_KP_F2:
-					special_key = GLUT_KEY_F2;
-					break;
-				case GDK_F3:
-				case GDK_KP_F3:
-					special_key = GLUT_KEY_F3;
-					break;
-				case GDK_F4:
-				case GDK_KP_F4:
-					special_key = GLUT_KEY_F4;
-					break;
-				case GDK_F5:
-					special_key = GLUT_KEY_F5;
-					break;
-				case GDK_F6:
-					special_key = GLUT_KEY_F6;
-					break;
-				case GDK_F7:
-					special_key = GLUT_KEY_F7;
-					break;
-				case GDK_F8:
-					special_key = GLUT_KEY_F8;
-					break;
-				case GDK_F9:
-					special_key = GLUT_KEY_F9;
-					break;
-				case GDK_F10:
-					special_key = GLUT_KEY_F10;
-					break;
-				case GDK_F11:
-					special_key = GLUT_KEY_F11;
-					break;
-				case GDK_F12:
-					special_key = GLUT_KEY_F12;
-					break;
-
-				case GDK_Left:
-				case GDK_KP_Left:
-					special_key = GLUT_KEY_LEFT;
-					break;
-				case GDK_Right:
-				case GDK_KP_Right:
-					special_key = GLUT_KEY_RIGHT;
-					break;
-				case GDK_Up:
-				case GDK_KP_Up:
-					special_key = GLUT_KEY_UP;
-					break;
-				case GDK_Down:
-				case GDK_KP_Down:
-					special_key = GLUT_KEY_DOWN;
-					break;
-
-				case GDK_Prior:
-				case GDK_KP_Prior:
-					special_key = GLUT_KEY_PAGE_UP;
-					break;
-				case GDK_Next:
-				case GDK_KP_Next:
-					special_key = GLUT_KEY_PAGE_DOWN;
-					break;
-				case GDK_Home:
-				case GDK_KP_Home:
-					special_key = GLUT_KEY_HOME;
-					break;
-				case GDK_End:
-				case GDK_KP_End:
-					special_key = GLUT_KEY_END;
-					break;
-				case GDK_Insert:
-				case GDK_KP_Insert:
-					special_key = GLUT_KEY_INSERT;
-					break;
-				}
+			if (key_type == __GTKGLUT_KEY_ASCII)
+				keyboard_func((unsigned char)key, mouse_x, mouse_y);
+			else
+				special_func(key, mouse_x, mouse_y);
 
-				if (special_func && special_key != -1) {
-					__gtkglut_context->keyboard_modifiers = event->state;
-					glutSetWindow(window_id);
-					special_func(special_key, mouse_x, mouse_y);
-					__gtkglut_context->keyboard_modifiers = __GTKGLUT_UNDEFINED;
-				}
-			}
+			__gtkglut_context->keyboard_modifiers = __GTKGLUT_UNDEFINED;
 		}
 	}
 
@@ -982,12 +1322,19 @@ gboolean __gtkglut_callback_mouse_press_handler(GtkWidget * widget, GdkEventButt
 
 	window_id = GPOINTER_TO_INT(data);
 
+	/*
+	 * Deliver compressed motion before button event
+	 */
+	__gtkglut_flush_window_motion(window_id);
+
 	glut_window = __gtkglut_get_window_by_id(window_id);
 
 	if (!glut_window) {
 		__gtkglut_warning("__gtkglut_callback_mouse_press",
 				  "Internal error. Attempt on bogus window %d", window_id);
 	} else {
+		__gtkglut_cache_pointer(glut_window, event->x, event->y);
+
 		button = __GTKGLUT_UNDEFINED;
 
 		switch (event->button) {
@@ -1111,6 +1458,8 @@ gboolean __gtkglut_callback_mouse_wheel_handler(GtkWidget * widget, GdkEventScro
 		__gtkglut_warning("__gtkglut_callback_mouse_wheel",
 				  "Internal error. Attempt on bogus window %d", window_id);
 	} else {
+		__gtkglut_cache_pointer(glut_window, event->x, event->y);
+
 		if (glut_window->signal_mouse_wheel.glut_callback_handler) {
 			callback_func =
 			    (void (*)(int wheel, int direction, int x, int y))glut_window->
@@ -1148,14 +1497,169 @@ gboolean __gtkglut_callback_mouse_wheel_handler(GtkWidget * widget, GdkEventScro
 }
 
 /*
- * GTK+ mouse motion handler
+ * Source delivering compressed motion. It has lower priority than GDK events,
+ * so it is dispatched after all pending motion events are queued.
  */
-gboolean __gtkglut_callback_motion_handler(GtkWidget * widget, GdkEventMotion * event,
+static gboolean __gtkglut_motion_source_prepare(GSource * source, gint * timeout)
+{
+
+	*timeout = -1;
+
+	return (__gtkglut_context->motion_windows->len > 0);
+}
+
+static gboolean __gtkglut_motion_source_check(GSource * source)
+{
+
+	return (__gtkglut_context->motion_windows->len > 0);
+}
+
+static gboolean __gtkglut_motion_source_dispatch(GSource * source, GSourceFunc callback,
+						 gpointer user_data)
+{
+	GPtrArray *motion_windows;
+	guint i;
+
+	motion_windows = __gtkglut_context->motion_windows;
+	__gtkglut_context->motion_windows = __gtkglut_context->motion_windows_flush;
+	__gtkglut_context->motion_windows_flush = motion_windows;
+
+	for (i = 0; i < motion_windows->len; i++) {
+		__gtkglut_flush_window_motion(GPOINTER_TO_INT(g_ptr_array_index(motion_windows, i)));
+	}
+
+	g_ptr_array_set_size(motion_windows, 0);
+
+	return TRUE;
+}
+
+static GSourceFuncs __gtkglut_motion_source_funcs = {
+	__gtkglut_motion_source_prepare,
+	__gtkglut_motion_source_check,
+	__gtkglut_motion_source_dispatch,
+	NULL
+};
+
+/*
+ * Deliver samples of window motion history to motion history callback and last
+ * sample to motion (or passive motion) callback.
+ */
+static void __gtkglut_deliver_motion(int window_id, __gtkglut_window_struct * glut_window,
+				     GArray * history, guint state)
+{
+	void (*callback_func) (int x, int y);
+	void (*history_func) (int state, int count, const GLUTmotionSample * samples);
+	GLUTmotionSample last;
+	gboolean active;
+
+	active = (state & (GDK_BUTTON1_MASK | GDK_BUTTON2_MASK | GDK_BUTTON3_MASK |
+			   GDK_BUTTON4_MASK | GDK_BUTTON5_MASK)) != 0;
+
+	if (active) {
+		callback_func = (void (*)(int x, int y))glut_window->signal_motion.glut_callback_handler;
+	} else {
+		callback_func =
+		    (void (*)(int x, int y))glut_window->signal_passive_motion.glut_callback_handler;
+	}
+
+	history_func = (void (*)(int state, int count, const GLUTmotionSample * samples))
+	    glut_window->signal_motion_history.glut_callback_handler;
+
+	last = g_array_index(history, GLUTmotionSample, history->len - 1);
+
+	__gtkglut_context->keyboard_modifiers = state;
+
+	if (history_func) {
+		glutSetWindow(window_id);
+		history_func(active ? GLUT_DOWN : GLUT_UP, history->len,
+			     (const GLUTmotionSample *)history->data);
+	}
+
+	/*
+	 * History callback can destroy window
+	 */
+	if (callback_func && __gtkglut_get_window_by_id(window_id) == glut_window) {
+		glutSetWindow(window_id);
+		callback_func(last.x, last.y);
+	}
+
+	__gtkglut_context->keyboard_modifiers = __GTKGLUT_UNDEFINED;
+
+	__gtkglut_gl_debug();
+}
+
+/*
+ * Deliver compressed motion of window. Called from motion source, and before
+ * other pointer events, so order of events is kept.
+ */
+void __gtkglut_flush_window_motion(int window_id)
+{
+	__gtkglut_window_struct *glut_window;
+	GArray *history;
+
+	glut_window = __gtkglut_get_window_by_id(window_id);
+
+	if (!glut_window || !glut_window->motion_history || glut_window->motion_history->len == 0)
+		return;
+
+	/*
+	 * Detach history from window, so callbacks can add new samples or destroy
+	 * window
+	 */
+	history = glut_window->motion_history;
+	glut_window->motion_history = NULL;
+
+	__gtkglut_deliver_motion(window_id, glut_window, history, glut_window->motion_state);
+
+	glut_window = __gtkglut_get_window_by_id(window_id);
+
+	if (glut_window && !glut_window->motion_history) {
+		g_array_set_size(history, 0);
+		glut_window->motion_history = history;
+	} else {
+		g_array_free(history, TRUE);
+	}
+}
+
+/*
+ * Enable or disable motion compression on current window
+ */
+void __gtkglut_set_motion_compression(int value)
+{
+	__gtkglut_window_struct *glut_window;
+
+	__gtkglut_test_inicialization("glutSetOption");
+
+	glut_window = __gtkglut_get_active_window_with_warning("glutSetOption");
+
+	if (!glut_window)
+		return;
+
+	if (!value) {
+		__gtkglut_flush_window_motion(glutGetWindow());
+	}
+
+	glut_window->motion_compression = (value != 0);
+
+	if (glut_window->motion_compression && !__gtkglut_context->motion_source) {
+		__gtkglut_context->motion_source =
+		    g_source_new(&__gtkglut_motion_source_funcs, sizeof(GSource));
+		g_source_set_priority(__gtkglut_context->motion_source, G_PRIORITY_HIGH_IDLE);
+		g_source_attach(__gtkglut_context->motion_source, NULL);
+	}
+}
+
+/*
+ * Handler for motion event. Without compression, event is delivered
+ * immediately, otherwise it's added to window motion history.
+ */
+gboolean __gtkglut_callback_motion_handler(GtkWidget * widget, GdkEventMotion * event,
 					   gpointer data)
 {
 	int window_id;
 	__gtkglut_window_struct *glut_window;
-	void (*callback_func) (int x, int y);
+	GLUTmotionSample sample;
+	guint buttons;
 
 	window_id = GPOINTER_TO_INT(data);
 
@@ -1164,31 +1668,61 @@ gboolean __gtkglut_callback_motion_handler(GtkWidget * widget, GdkEventMotion *
 	if (!glut_window) {
 		__gtkglut_warning("__gtkglut_callback_motion",
 				  "Internal error. Attempt on bogus window %d", window_id);
-	} else {
+
+		return TRUE;
+	}
+
+	__gtkglut_cache_pointer(glut_window, event->x, event->y);
+
+	if (!glut_window->signal_motion.glut_callback_handler &&
+	    !glut_window->signal_passive_motion.glut_callback_handler &&
+	    !glut_window->signal_motion_history.glut_callback_handler) {
 		/*
-		 * Call active or passive callback
+		 * Signal is connected only for pointer cache
 		 */
-		if (event->state & GDK_BUTTON1_MASK || event->state & GDK_BUTTON2_MASK
-		    || event->state & GDK_BUTTON3_MASK || event->state & GDK_BUTTON4_MASK
-		    || event->state & GDK_BUTTON5_MASK) {
-			callback_func =
-			    (void (*)(int x, int y))glut_window->signal_motion.
-			    glut_callback_handler;
-		} else {
-			callback_func =
-			    (void (*)(int x, int y))glut_window->signal_passive_motion.
-			    glut_callback_handler;
-		}
+		return TRUE;
+	}
 
-		if (callback_func) {
-			__gtkglut_context->keyboard_modifiers = event->state;
-			glutSetWindow(window_id);
-			callback_func((int)event->x, (int)event->y);
-			__gtkglut_context->keyboard_modifiers = __GTKGLUT_UNDEFINED;
-		}
+	buttons = GDK_BUTTON1_MASK | GDK_BUTTON2_MASK | GDK_BUTTON3_MASK |
+	    GDK_BUTTON4_MASK | GDK_BUTTON5_MASK;
+
+	if (glut_window->motion_history && glut_window->motion_history->len > 0 &&
+	    (glut_window->motion_state & buttons) != (event->state & buttons)) {
+		/*
+		 * Active and passive motion is never merged
+		 */
+		__gtkglut_flush_window_motion(window_id);
+
+		glut_window = __gtkglut_get_window_by_id(window_id);
+		if (!glut_window)
+			return TRUE;
 	}
 
-	__gtkglut_gl_debug();
+	if (!glut_window->motion_history) {
+		glut_window->motion_history = g_array_new(FALSE, FALSE, sizeof(GLUTmotionSample));
+	}
+
+	sample.x = (int)event->x;
+	sample.y = (int)event->y;
+	sample.time = event->time;
+
+	if (glut_window->motion_history->len > 0
+	    && !glut_window->signal_motion_history.glut_callback_handler) {
+		/*
+		 * Nobody wants history -> keep only last sample
+		 */
+		g_array_index(glut_window->motion_history, GLUTmotionSample, 0) = sample;
+	} else {
+		g_array_append_val(glut_window->motion_history, sample);
+	}
+
+	glut_window->motion_state = event->state;
+
+	if (!glut_window->motion_compression) {
+		__gtkglut_flush_window_motion(window_id);
+	} else if (glut_window->motion_history->len == 1) {
+		g_ptr_array_add(__gtkglut_context->motion_windows, GINT_TO_POINTER(window_id));
+	}
 
 	return TRUE;
 }
@@ -1206,6 +1740,8 @@ gboolean __gtkglut_callback_enter_leave_handler(GtkWidget * widget, GdkEventCros
 
 	window_id = GPOINTER_TO_INT(data);
 
+	__gtkglut_flush_window_motion(window_id);
+
 	glut_window = __gtkglut_get_window_by_id(window_id);
 
 	/*
@@ -1220,10 +1756,16 @@ gboolean __gtkglut_callback_enter_leave_handler(GtkWidget * widget, GdkEventCros
 		/*
 		 * Call active or passive callback
 		 */
-		if (event->type == GDK_ENTER_NOTIFY)
+		if (event->type == GDK_ENTER_NOTIFY) {
 			state = GLUT_ENTERED;
-		else
+			__gtkglut_cache_pointer(glut_window, event->x, event->y);
+		} else {
 			state = GLUT_LEFT;
+			/*
+			 * Outside of window, we get no motion events
+			 */
+			glut_window->pointer_valid = FALSE;
+		}
 
 		callback_func =
 		    (void (*)(int state))glut_window->signal_entry.glut_callback_handler;
@@ -1239,6 +1781,68 @@ gboolean __gtkglut_callback_enter_leave_handler(GtkWidget * widget, GdkEventCros
 	return TRUE;
 }
 
+/*
+ * GDK event handler. Input events of GtkGLUT windows are given directly to handler
+ * from window event table, everything else goes to GTK+ as usual. Key events are
+ * delivered to toplevel, so they belong to window with focus. Handled events skip
+ * gtk_main_do_event(), so GTK+ current event and key snoopers don't see them.
+ * While GTK+ grab is active, window gets events only if it is inside grab widget,
+ * like in gtk_main_do_event().
+ */
+void __gtkglut_event_dispatch(GdkEvent * event, gpointer data)
+{
+	gpointer user_data;
+	GtkWidget *widget;
+	int window_id;
+	__gtkglut_window_struct *glut_window;
+	__gtkglut_event_func handler;
+	GtkWidget *grab_widget;
+
+	if (!__gtkglut_context->event_dispatch || (int)event->type < 0
+	    || event->type >= __GTKGLUT_EVENT_TABLE_SIZE || !event->any.window) {
+		gtk_main_do_event(event);
+
+		return;
+	}
+
+	user_data = NULL;
+	window_id = 0;
+	gdk_window_get_user_data(event->any.window, &user_data);
+	widget = (GtkWidget *) user_data;
+
+	if (widget && (event->type == GDK_KEY_PRESS || event->type == GDK_KEY_RELEASE)
+	    && GTK_IS_WINDOW(widget)) {
+		widget = gtk_window_get_focus(GTK_WINDOW(widget));
+	}
+
+	handler = NULL;
+
+	if (widget) {
+		window_id =
+		    GPOINTER_TO_INT(g_object_get_qdata
+				    (G_OBJECT(widget), __gtkglut_context->window_id_quark));
+
+		glut_window = (window_id ? __gtkglut_get_window_by_id(window_id) : NULL);
+
+		if (glut_window)
+			handler = glut_window->event_table[event->type];
+	}
+
+	grab_widget = gtk_grab_get_current();
+
+	if (handler && grab_widget && widget != grab_widget
+	    && !gtk_widget_is_ancestor(widget, grab_widget))
+		handler = NULL;
+
+	if (!handler) {
+		gtk_main_do_event(event);
+
+		return;
+	}
+
+	handler(widget, event, GINT_TO_POINTER(window_id));
+}
+
 /*
  * Create window. Universal function for creating toplevel (parent<0) and sub windows
  */
@@ -1368,6 +1972,9 @@ int __gtkglut_create_window(char *func_name, int parent, __gtkglut_geometry_stru
 	glut_window->parent_window = parent;
 	glut_window->drawing_area = drawing_area;
 	glut_window->fixed = fixed;
+
+	__gtkglut_fb_config_snapshot(glut_window);
+
 	glut_window->first_displayed = FALSE;
 	glut_window->callback_display = NULL;
 	glut_window->callback_reshape = NULL;
@@ -1376,6 +1983,29 @@ int __gtkglut_create_window(char *func_name, int parent, __gtkglut_geometry_stru
 	glut_window->current_cursor = GLUT_CURSOR_INHERIT;
 	glut_window->damaged = TRUE;
 	glut_window->iconified = (parent < 0 && __gtkglut_context->window_init_iconic);
+	glut_window->redisplay_pending = FALSE;
+	glut_window->redisplay_deferred = FALSE;
+	glut_window->geometry_size_valid = FALSE;
+	glut_window->geometry_position_valid = FALSE;
+	glut_window->pointer_x = 0;
+	glut_window->pointer_y = 0;
+	glut_window->pointer_valid = FALSE;
+
+	for (i = 0; i < __GTKGLUT_MAX_FRAMES_IN_FLIGHT; i++)
+		glut_window->frame_fences[i] = NULL;
+	glut_window->frames_in_flight = 0;
+	glut_window->frame_fence_index = 0;
+	glut_window->frame_stats = NULL;
+
+	if (parent > 0 && parent_glut_window->geometry_position_valid) {
+		/*
+		 * Position of subwindow is position of toplevel
+		 */
+		glut_window->geometry.x = parent_glut_window->geometry.x;
+		glut_window->geometry.y = parent_glut_window->geometry.y;
+		glut_window->geometry_position_valid = TRUE;
+	}
+
 	glut_window->user_data = NULL;
 
 	glut_window->window_visible = FALSE;
@@ -1438,14 +2068,26 @@ int __gtkglut_create_window(char *func_name, int parent, __gtkglut_geometry_stru
 	glut_window->signal_entry.glut_callback_handler = NULL;
 	glut_window->signal_entry.event_added = FALSE;
 
+	glut_window->signal_motion_history.gtk_event_handler =
+	    (void *)__gtkglut_callback_motion_handler;
+	glut_window->signal_motion_history.glut_callback_handler = NULL;
+	glut_window->signal_motion_history.event_added = FALSE;
+
+	for (i = 0; i < __GTKGLUT_EVENT_TABLE_SIZE; i++) {
+		glut_window->event_table[i] = NULL;
+		glut_window->event_signal[i] = 0;
+	}
+
+	glut_window->motion_compression = FALSE;
+	glut_window->motion_history = NULL;
+	glut_window->motion_state = 0;
+
 	glut_window->callback_close = NULL;
 
 	for (i = 0; i < __GTKGLUT_MAX_MOUSE_BUTTONS; i++)
 		glut_window->mouse_button_menu[i] = 0;
 
-	__gtkglut_window_array_append(glut_window);
-
-	window_id = __gtkglut_context->window_array->len - 1;
+	window_id = __gtkglut_window_array_append(glut_window);
 
 	if (parent > 0) {
 		/*
@@ -1466,6 +2108,10 @@ int __gtkglut_create_window(char *func_name, int parent, __gtkglut_geometry_stru
 		g_signal_connect(G_OBJECT(window), "window-state-event",
 				 G_CALLBACK(__gtkglut_window_state_handler),
 				 GINT_TO_POINTER(window_id));
+
+		g_signal_connect(G_OBJECT(window), "configure-event",
+				 G_CALLBACK(__gtkglut_toplevel_configure_event),
+				 GINT_TO_POINTER(window_id));
 	}
 
 	g_signal_connect(G_OBJECT(event_box), "size_allocate",
@@ -1479,9 +2125,13 @@ int __gtkglut_create_window(char *func_name, int parent, __gtkglut_geometry_stru
 	g_signal_connect(G_OBJECT(drawing_area), "expose_event",
 			 G_CALLBACK(__gtkglut_callback_expose_handler), GINT_TO_POINTER(window_id));
 
-	g_signal_connect(G_OBJECT(drawing_area), "enter-notify-event",
-			 G_CALLBACK(__gtkglut_callback_enter_leave_handler),
-			 GINT_TO_POINTER(window_id));
+	/*
+	 * Event dispatcher finds window by drawing area
+	 */
+	g_object_set_qdata(G_OBJECT(drawing_area), __gtkglut_context->window_id_quark,
+			   GINT_TO_POINTER(window_id));
+
+	__gtkglut_window_events_update(glut_window, window_id);
 
 	glutSetWindow(window_id);
 
@@ -1606,6 +2256,98 @@ int glutCreateSubWindow(int win, int x, int y, int width, int height)
 	return window_id;
 }
 
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
+/*
+ * Maximal wait for one fence in nanoseconds
+ */
+#define __GTKGLUT_FENCE_TIMEOUT 1000000000
+
+/*
+ * Resolve ARB_sync functions. Must be called with current GL context.
+ */
+static void __gtkglut_fence_sync_init(void)
+{
+	__gtkglut_context->fence_sync_supported = FALSE;
+
+	if (!gdk_gl_query_gl_extension("GL_ARB_sync"))
+		return;
+
+	__gtkglut_context->gl_fence_sync = (gpointer(APIENTRY *) (GLenum, GLbitfield))
+	    glutGetProcAddress("glFenceSync");
+	__gtkglut_context->gl_client_wait_sync =
+	    (GLenum(APIENTRY *) (gpointer, GLbitfield, guint64))
+	    glutGetProcAddress("glClientWaitSync");
+	__gtkglut_context->gl_delete_sync = (void (APIENTRY *) (gpointer))
+	    glutGetProcAddress("glDeleteSync");
+
+	__gtkglut_context->fence_sync_supported = __gtkglut_context->gl_fence_sync &&
+	    __gtkglut_context->gl_client_wait_sync && __gtkglut_context->gl_delete_sync;
+}
+
+/*
+ * Drop frame fences of window. Sync objects are deleted only if GL context of window
+ * is current (in_context), otherwise they are just forgotten.
+ */
+void __gtkglut_frame_fences_delete(__gtkglut_window_struct * glut_window, gboolean in_context)
+{
+	int i;
+
+	for (i = 0; i < __GTKGLUT_MAX_FRAMES_IN_FLIGHT; i++) {
+		if (glut_window->frame_fences[i]) {
+			if (in_context)
+				__gtkglut_context->gl_delete_sync(glut_window->frame_fences[i]);
+
+			glut_window->frame_fences[i] = NULL;
+		}
+	}
+
+	glut_window->frame_fence_index = 0;
+}
+
+/*
+ * Insert fence after frame of current window and wait for fence of frame
+ * max_frames_in_flight frames old. Fences left from different limit are dropped.
+ */
+static void __gtkglut_frame_fence(__gtkglut_window_struct * glut_window)
+{
+	gpointer *fence;
+
+	if (__gtkglut_context->fence_sync_supported == __GTKGLUT_UNDEFINED)
+		__gtkglut_fence_sync_init();
+
+	if (!__gtkglut_context->fence_sync_supported)
+		return;
+
+	if (glut_window->frames_in_flight != __gtkglut_context->max_frames_in_flight) {
+		__gtkglut_frame_fences_delete(glut_window, TRUE);
+
+		glut_window->frames_in_flight = __gtkglut_context->max_frames_in_flight;
+	}
+
+	if (!glut_window->frames_in_flight)
+		return;
+
+	fence = &glut_window->frame_fences[glut_window->frame_fence_index];
+
+	if (*fence) {
+		__gtkglut_context->gl_client_wait_sync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+						       __GTKGLUT_FENCE_TIMEOUT);
+		__gtkglut_context->gl_delete_sync(*fence);
+	}
+
+	*fence = __gtkglut_context->gl_fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	glut_window->frame_fence_index =
+	    (glut_window->frame_fence_index + 1) % glut_window->frames_in_flight;
+}
+
 /*!
  * \brief    Swaps the buffers for the current window.
  * \ingroup  window
@@ -1615,11 +2357,11 @@ int glutCreateSubWindow(int win, int x, int y, int width, int height)
  * double-buffered (\a GLUT_DOUBLE param to glutInitDisplayMode()),
  * then GtkGLUT will swap the front buffer with the back buffer.
  *
- * \note Function call glFlush automaticly. For single buffer this is only
- *       one effect, so you can use always this function.
+ * \note For single buffer window function calls glFlush, so you can use
+ *       always this function.  Swap of double buffer window implies flush.
  * \see glutPostRedisplay(), glutPostOverlayRedisplay(),
  *      glutPostWindowRedisplay(), glutPostWindowOverlayRedisplay(),
- *      glutInitDisplaymode()
+ *      glutInitDisplaymode(), glutSwapInterval()
  */
 void glutSwapBuffers(void)
 {
@@ -1629,14 +2371,131 @@ void glutSwapBuffers(void)
 
 	glut_window = __gtkglut_get_active_window_with_warning("glutSwapBuffers");
 
-	if (glut_window) {
+	if (glut_window && __gtkglut_context->current_gl_drawable) {
+		if (glut_window->fb_config.doublebuffer) {
+			gdk_gl_drawable_swap_buffers(__gtkglut_context->current_gl_drawable);
+		} else {
+			glFlush();
+		}
+
+		if (__gtkglut_context->max_frames_in_flight || glut_window->frames_in_flight)
+			__gtkglut_frame_fence(glut_window);
+
+		if (__gtkglut_context->frame_stats)
+			__gtkglut_frame_stats_swap(glut_window);
+	}
+}
+
+/*
+ * Set swap interval of current window through GLX/WGL swap control extensions.
+ * Returns FALSE, if interval is not supported.
+ */
+static gboolean __gtkglut_set_swap_interval(__gtkglut_window_struct * glut_window, int interval)
+{
+	GdkGLConfig *gl_config;
+#ifdef GDK_WINDOWING_X11
+	GdkGLWindow *gl_window;
+	void (*swap_interval_ext) (Display * dpy, GLXDrawable drawable, int interval);
+	int (*swap_interval_mesa) (unsigned int interval);
+	int (*swap_interval_sgi) (int interval);
+#endif
+#ifdef GDK_WINDOWING_WIN32
+	BOOL(WINAPI * swap_interval_wgl) (int interval);
+#endif
+
+	gl_config = gtk_widget_get_gl_config(glut_window->drawing_area);
+
+#ifdef GDK_WINDOWING_X11
+	if (interval < 0
+	    && !gdk_x11_gl_query_glx_extension(gl_config, "GLX_EXT_swap_control_tear")) {
 		/*
-		 * Default is call glFlush before swap
+		 * Adaptive vsync is not available -> use normal vsync
 		 */
-		glFlush();
+		interval = -interval;
+	}
 
-		if (gdk_gl_drawable_is_double_buffered(__gtkglut_context->current_gl_drawable)) {
-			gdk_gl_drawable_swap_buffers(__gtkglut_context->current_gl_drawable);
+	if (gdk_x11_gl_query_glx_extension(gl_config, "GLX_EXT_swap_control")) {
+		swap_interval_ext = (void (*)(Display *, GLXDrawable, int))
+		    glutGetProcAddress("glXSwapIntervalEXT");
+
+		if (swap_interval_ext) {
+			gl_window = gtk_widget_get_gl_window(glut_window->drawing_area);
+
+			swap_interval_ext(gdk_x11_gl_config_get_xdisplay(gl_config),
+					  gdk_x11_gl_window_get_glxwindow(gl_window), interval);
+			return TRUE;
+		}
+	}
+
+	if (interval < 0)
+		interval = -interval;
+
+	if (gdk_x11_gl_query_glx_extension(gl_config, "GLX_MESA_swap_control")) {
+		swap_interval_mesa =
+		    (int (*)(unsigned int))glutGetProcAddress("glXSwapIntervalMESA");
+
+		if (swap_interval_mesa)
+			return (swap_interval_mesa((unsigned int)interval) == 0);
+	}
+
+	/*
+	 * SGI extension can't disable vsync
+	 */
+	if (interval > 0 && gdk_x11_gl_query_glx_extension(gl_config, "GLX_SGI_swap_control")) {
+		swap_interval_sgi = (int (*)(int))glutGetProcAddress("glXSwapIntervalSGI");
+
+		if (swap_interval_sgi)
+			return (swap_interval_sgi(interval) == 0);
+	}
+#endif
+
+#ifdef GDK_WINDOWING_WIN32
+	if (interval < 0 && !gdk_win32_gl_query_wgl_extension(gl_config, "WGL_EXT_swap_control_tear"))
+		interval = -interval;
+
+	if (gdk_win32_gl_query_wgl_extension(gl_config, "WGL_EXT_swap_control")) {
+		swap_interval_wgl = (BOOL(WINAPI *) (int))glutGetProcAddress("wglSwapIntervalEXT");
+
+		if (swap_interval_wgl)
+			return swap_interval_wgl(interval);
+	}
+#endif
+
+	return FALSE;
+}
+
+/*!
+ * \brief    Set swap interval of the current window.
+ * \ingroup  window
+ * \param    interval    Minimal number of video frames between buffer swaps.
+ *
+ * With \a interval 0, glutSwapBuffers() swaps immediately (vsync is
+ * disabled), with 1 swap waits for next vertical retrace and so on.
+ * Negative \a interval requests adaptive vsync: swap waits for
+ * retrace, unless frame is late, in which case it swaps immediately.
+ * If adaptive vsync is not available, absolute value of \a interval
+ * is used.
+ *
+ * Interval is set through GLX_EXT_swap_control, GLX_MESA_swap_control
+ * or GLX_SGI_swap_control on X11 and WGL_EXT_swap_control on Windows,
+ * what is available.  If none is, warning is shown.
+ *
+ * This function is bound to the *current window*.
+ *
+ * \see glutSwapBuffers()
+ */
+void glutSwapInterval(int interval)
+{
+	__gtkglut_window_struct *glut_window;
+
+	__gtkglut_test_inicialization("glutSwapInterval");
+
+	glut_window = __gtkglut_get_active_window_with_warning("glutSwapInterval");
+
+	if (glut_window && __gtkglut_context->current_gl_drawable) {
+		if (!__gtkglut_set_swap_interval(glut_window, interval)) {
+			__gtkglut_warning("glutSwapInterval", "swap interval %d is not supported",
+					  interval);
 		}
 	}
 }
@@ -1859,6 +2718,19 @@ void glutPopWindow(void)
 	}
 }
 
+/*
+ * Add window to set of windows with pending redisplay. Redisplay is executed
+ * from redisplay source, in next main loop iteration.
+ */
+void __gtkglut_queue_window_redisplay(__gtkglut_window_struct * glut_window, int window_id)
+{
+
+	if (!glut_window->redisplay_pending) {
+		glut_window->redisplay_pending = TRUE;
+		g_ptr_array_add(__gtkglut_context->dirty_windows, GINT_TO_POINTER(window_id));
+	}
+}
+
 /*
  * Internal function, which send reguest for redisplay window win, used by
  * glutPostRedisplay and glutPostWindowRedisplay.
@@ -1874,8 +2746,7 @@ void __gtkglut_post_window_redisplay(char *func_name, int win)
 	if (!glut_window) {
 		__gtkglut_warning(func_name, "attempted on bogus window %d!", win);
 	} else {
-		gdk_window_invalidate_rect(glut_window->drawing_area->window,
-					   &glut_window->drawing_area->allocation, FALSE);
+		__gtkglut_queue_window_redisplay(glut_window, win);
 	}
 }
 